@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Compare bench_suite results against a stored baseline.
+
+Baselines live in bench/baseline.json, keyed by a machine fingerprint
+(CPU model, core count, architecture, compiler), so numbers recorded on
+one host are never compared with another's.
+
+    python3 bench_compare.py bench/current.json            # compare, exit 1 on regression
+    python3 bench_compare.py bench/current.json --update   # record as this host's baseline
+
+A case only counts as a regression when its median is slower by more
+than the larger of --threshold percent and --noise times the relative MAD
+of the baseline or current run (whichever is noisier), and its fastest
+repetition is slower by that much too. The second check keeps a burst of
+contention on a shared host from failing the build.
+"""
+import argparse
+import hashlib
+import json
+import os
+import platform
+import subprocess
+import sys
+from datetime import date
+
+DEFAULT_BASELINE = os.path.join("bench", "baseline.json")
+
+
+def machine_info() -> dict:
+    """Describe this host closely enough that timings are comparable."""
+    cpu = platform.processor() or "unknown"
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    cpu = line.split(":", 1)[1].strip()
+                    break
+    except OSError:
+        pass
+
+    cc = os.environ.get("CC", "gcc")
+    try:
+        compiler = subprocess.run(
+            [cc, "--version"], capture_output=True, text=True, check=True
+        ).stdout.splitlines()[0]
+    except (OSError, subprocess.CalledProcessError, IndexError):
+        compiler = cc
+
+    return {
+        "cpu": cpu,
+        "cores": os.cpu_count(),
+        "arch": platform.machine(),
+        "system": platform.system(),
+        "compiler": compiler,
+    }
+
+
+def fingerprint(info: dict) -> str:
+    key = json.dumps(info, sort_keys=True).encode("utf8")
+    return hashlib.sha1(key).hexdigest()[:12]
+
+
+def load_json(path: str) -> dict:
+    with open(path) as f:
+        return json.load(f)
+
+
+def compare(baseline: dict, current: dict, threshold: float, noise: float) -> int:
+    """Print the delta table and return the number of regressions."""
+    base_cases = {c["name"]: c for c in baseline["cases"]}
+    regressions = 0
+
+    print(f"{'case':<24} {'unit':<9} {'baseline':>12} {'current':>12} {'delta':>8} {'allowed':>8}  status")
+    for cur in current["cases"]:
+        base = base_cases.get(cur["name"])
+        if base is None:
+            print(f"{cur['name']:<24} {cur['unit']:<9} {'-':>12} {cur['median']:>12.0f} {'':>8} {'':>8}  new")
+            continue
+
+        delta = (cur["median"] - base["median"]) / base["median"] * 100
+        delta_min = (cur["min"] - base["min"]) / base["min"] * 100
+        rel_noise = max(base["mad"] / base["median"], cur["mad"] / cur["median"]) * 100
+        allowed = max(threshold, noise * rel_noise)
+
+        if delta > allowed and delta_min > allowed:
+            status = "REGRESSION"
+            regressions += 1
+        elif delta < -allowed and delta_min < -allowed:
+            status = "improved"
+        else:
+            status = "ok"
+
+        print(f"{cur['name']:<24} {cur['unit']:<9} {base['median']:>12.0f} {cur['median']:>12.0f} "
+              f"{delta:>+7.1f}% {allowed:>7.1f}%  {status}")
+
+    missing = sorted(set(base_cases) - {c["name"] for c in current["cases"]})
+    for name in missing:
+        print(f"{name:<24} {'':<9} {base_cases[name]['median']:>12.0f} {'-':>12} {'':>8} {'':>8}  missing")
+
+    return regressions
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("results", help="JSON written by bench_suite")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE)
+    parser.add_argument("--update", action="store_true",
+                        help="store results as the baseline for this machine")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="minimum slowdown in percent to flag (default 5)")
+    parser.add_argument("--noise", type=float, default=3.0,
+                        help="flag only beyond this many relative MADs (default 3)")
+    args = parser.parse_args()
+
+    current = load_json(args.results)
+    info = machine_info()
+    fp = fingerprint(info)
+
+    baselines = load_json(args.baseline) if os.path.exists(args.baseline) else {"machines": {}}
+
+    if args.update:
+        baselines["machines"][fp] = {
+            "machine": info,
+            "recorded": date.today().isoformat(),
+            "cases": current["cases"],
+        }
+        os.makedirs(os.path.dirname(args.baseline) or ".", exist_ok=True)
+        with open(args.baseline, "w") as f:
+            json.dump(baselines, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print(f"Recorded baseline for {fp} ({info['cpu']}, {info['cores']} cores) in {args.baseline}")
+        return 0
+
+    entry = baselines["machines"].get(fp)
+    if entry is None:
+        print(f"No baseline for this machine ({fp}: {info['cpu']}, {info['cores']} cores).")
+        print("Record one with: make bench-baseline")
+        return 0
+
+    print(f"Machine {fp}: {info['cpu']}, {info['cores']} cores; baseline from {entry['recorded']}\n")
+    regressions = compare(entry, current, args.threshold, args.noise)
+    if regressions:
+        print(f"\n{regressions} case(s) regressed")
+        return 1
+    print("\nNo significant regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
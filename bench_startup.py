@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""
+Measure TUI startup: how long until the chooser's first frame is drawn.
+
+Each run is a fresh interpreter (PYTHONPATH=src, so build the extension
+first with make rebuild-ext). Reported per stage, in ms since the process
+was spawned:
+
+    import_game        tboggle.game imported (libwords is loaded lazily)
+    import_ui          tboggle.chooser and textual imported
+    first_frame        chooser's first frame rendered (headless)
+    dictionary_ready   libwords, words.dat and definitions loaded
+
+    python3 bench_startup.py                 # lazy load, warmup behind the chooser
+    python3 bench_startup.py --eager         # load everything before the chooser
+
+Without textual installed, the UI stages are skipped.
+"""
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import time
+
+CHILD = r"""
+import json, sys, time
+spawned, eager = float(sys.argv[1]), sys.argv[2] == "1"
+out = {}
+def mark(stage):
+    out[stage] = (time.time() - spawned) * 1000
+
+import tboggle.game as game
+mark("import_game")
+if eager:
+    game.c_words.load()
+else:
+    game.warmup()
+try:
+    from tboggle.chooser import Chooser
+except ImportError:
+    Chooser = None
+if Chooser:
+    mark("import_ui")
+
+    class FirstFrame(Chooser):
+        def on_mount(self):
+            self.call_after_refresh(self.exit)
+
+    FirstFrame().run(headless=True)
+    mark("first_frame")
+game.c_words.load()
+mark("dictionary_ready")
+print(json.dumps(out))
+"""
+
+STAGES = ["import_game", "import_ui", "first_frame", "dictionary_ready"]
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--runs", type=int, default=10)
+    parser.add_argument("--eager", action="store_true", help="load libwords before the chooser")
+    args = parser.parse_args()
+
+    env = dict(os.environ, PYTHONPATH="src" + os.pathsep + os.environ.get("PYTHONPATH", ""))
+    samples = {stage: [] for stage in STAGES}
+    for _ in range(args.runs):
+        spawned = time.time()
+        result = subprocess.run(
+            [sys.executable, "-c", CHILD, repr(spawned), "1" if args.eager else "0"],
+            env=env, capture_output=True, text=True,
+        )
+        if result.returncode != 0:
+            sys.stderr.write(result.stderr)
+            return 1
+        for stage, ms in json.loads(result.stdout.splitlines()[-1]).items():
+            samples[stage].append(ms)
+
+    print(f"{'stage':18} {'median ms':>10} {'min ms':>10}   ({args.runs} runs, "
+          f"{'eager' if args.eager else 'lazy'} load)")
+    for stage in STAGES:
+        if samples[stage]:
+            print(f"{stage:18} {statistics.median(samples[stage]):10.1f} {min(samples[stage]):10.1f}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "dice_sets.h"
+#include "libwords.h"
+#include "perf_counters.h"
+
+/**
+ * LIBWORDS BENCHMARK SUITE
+ *
+ * Runs a fixed set of solve and board-generation cases and prints the
+ * results as JSON on stdout (progress goes to stderr). Each case is run
+ * several times; we report the median, the median absolute deviation
+ * (MAD) and the minimum so bench_compare.py can tell real regressions
+ * from run-to-run noise.
+ *
+ *   ./bench_suite                 all cases, 7 repetitions
+ *   ./bench_suite --reps 15       more repetitions for a noisy host
+ *   ./bench_suite --filter solve  only cases whose name contains "solve"
+ *   ./bench_suite --counters      also read hardware counters (Linux perf)
+ *   ./bench_suite --words FILE    use a word list as the dictionary (load_word_list)
+ *
+ * With --counters each case also reports cycles, instructions, L1D and
+ * LLC misses and branch misses per unit of work, summed over the timed
+ * repetitions. If the kernel will not give us counters (no PMU in a VM,
+ * perf_event_paranoid) the suite says so on stderr and reports timing only.
+ *
+ * Built with make STATS=1 every case also reports the solver counters
+ * per unit, and hardware counters are additionally normalized per DAWG
+ * step (one node touched in a sibling scan). Counting slows the solver,
+ * so don't record baselines from a STATS build.
+ *
+ * fill cases also report prefilter_reject_rate, the share of boards past
+ * the heuristics that fill_board()'s relaxed-bound prefilter rejected
+ * (from one extra untimed run with telemetry on).
+ *
+ * interleaved/<set> solves the same boards as solve/<set> with
+ * solve_boards(), the interleaved batch solver, so the pair shows what
+ * overlapping the searches buys on this machine.
+ *
+ * solve/<set> always uses the DAWG engine and reverse/<set> the reverse
+ * engine on the same boards; fill cases use the dictionary's default.
+ * Run with --words on a small list to see where the reverse engine wins.
+ *
+ * Boards are rolled with a fixed seed and generation cases use fixed
+ * random seeds, so every run does identical work.
+ */
+
+#define BOARDS_PER_SOLVE_CASE 200
+#define MAX_REPS 101
+
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+/**
+ * One benchmark case. run() performs one repetition and returns how many
+ * units of work it did (boards solved or generated) so results are
+ * reported per unit and stay comparable if the workload size changes.
+ */
+struct bench_case {
+    char name[48];
+    const char *unit;
+    long (*run)(const struct bench_case *c);
+
+    // solve cases
+    int engine;                  // set_solver_engine() for the case
+    const struct dice_set *set;
+    char (*boards)[MAX_DICE + 1];
+    const char **board_ptrs;     // boards, for solve_boards()
+    int num_boards;
+
+    // fill cases
+    int min_words, max_words, min_longest, seeds;
+};
+
+static double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static long run_solve(const struct bench_case *c) {
+    set_solver_engine(c->engine);
+    for (int i = 0; i < c->num_boards; i++) {
+        restore_game(g_scores, c->set->num, c->set->num, c->boards[i]);
+    }
+    return c->num_boards;
+}
+
+static long run_interleaved(const struct bench_case *c) {
+    // Same boards and word rules as run_solve, totals only
+    struct board_totals totals[BOARDS_PER_SOLVE_CASE];
+    solve_boards(g_scores, c->set->num, c->set->num, c->board_ptrs, c->num_boards, 0, totals, NULL);
+    return c->num_boards;
+}
+
+static long run_fill(const struct bench_case *c) {
+    // Same shape as benchmark_heuristics.c, always on the 4x4 revised set
+    const struct dice_set *set = find_dice_set("4");
+    char *dice[MAX_DICE];
+    int num_tries;
+    char *dice_simple;
+
+    set_solver_engine(c->engine);
+
+    for (int seed = 1; seed <= c->seeds; seed++) {
+        for (int i = 0; i < 16; i++) dice[i] = (char *)set->dice[i];
+        get_words(dice, g_scores, 4, 4, c->min_words, c->max_words, 1, -1, c->min_longest, -1, 3,
+                  1000000, seed, &num_tries, &dice_simple);
+    }
+    return c->seeds;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    const double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *v, int n) {
+    qsort(v, n, sizeof(double), cmp_double);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static void measure(const struct bench_case *c, int reps, bool first, struct perf_counters *pc) {
+    double per_unit[MAX_REPS], dev[MAX_REPS];
+    uint64_t counts[PC_NUM] = {0};
+    long total_units = 0;
+
+    c->run(c);  // Warm caches and page in the dictionary
+    reset_solver_stats();
+    for (int r = 0; r < reps; r++) {
+        if (pc) perf_counters_start(pc);
+        const double t0 = now_ns();
+        const long units = c->run(c);
+        per_unit[r] = (now_ns() - t0) / units;
+        if (pc) perf_counters_stop(pc, counts);
+        total_units += units;
+    }
+
+    const double med = median(per_unit, reps);
+    for (int r = 0; r < reps; r++) dev[r] = per_unit[r] > med ? per_unit[r] - med : med - per_unit[r];
+    const double mad = median(dev, reps);
+    // per_unit was sorted by median()
+    const double min = per_unit[0];
+
+    fprintf(stderr, "  %-24s %12.0f %s (mad %.1f%%)\n", c->name, med, c->unit, 100 * mad / med);
+    printf("%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"reps\": %d, "
+           "\"median\": %.1f, \"mad\": %.1f, \"min\": %.1f",
+           first ? "" : ",", c->name, c->unit, reps, med, mad, min);
+
+    if (c->run == run_fill) {
+        // One more, untimed, run with telemetry: how often the relaxed-bound
+        // prefilter spared fill_board() an exact solve
+        struct fill_telemetry t;
+        reset_fill_telemetry();
+        enable_fill_telemetry(true);
+        c->run(c);
+        enable_fill_telemetry(false);
+        get_fill_telemetry(&t);
+        const long long screened = t.attempts - t.outcomes[ATTEMPT_HEURISTIC];
+        const double rate = screened ? (double)t.outcomes[ATTEMPT_PREFILTER] / screened : 0;
+        printf(", \"prefilter_reject_rate\": %.4f", rate);
+        fprintf(stderr, "  %24s prefilter rejected %.1f%% of %lld boards screened\n", "", 100 * rate, screened);
+    }
+
+    struct solver_stats st;
+    const bool have_stats = get_solver_stats(&st);
+    const double steps = have_stats ? (double)(st.dawg_lookups + st.sibling_steps) : 0;
+    if (have_stats) {
+        const double n = total_units;
+        printf(", \"solver\": {\"nodes\": %.1f, \"dawg_steps\": %.1f, \"rejected_bounds\": %.1f, "
+               "\"rejected_used\": %.1f, \"rejected_no_child\": %.1f, \"inserted\": %.1f, "
+               "\"duplicates\": %.1f, \"fail_fast\": %.3f}",
+               st.nodes_visited / n, steps / n, st.rejected_bounds / n, st.rejected_used / n,
+               st.rejected_no_child / n, st.words_inserted / n, st.duplicates / n,
+               st.fail_fast_exits / n);
+        fprintf(stderr, "  %24s nodes=%.0f dawg_steps=%.0f\n", "", st.nodes_visited / n, steps / n);
+    }
+
+    if (pc) {
+        // Counters are normalized per unit of work (per board)
+        printf(", \"counters\": {");
+        fprintf(stderr, "  %24s", "");
+        bool first_counter = true;
+        for (int i = 0; i < PC_NUM; i++) {
+            if (pc->fds[i] < 0) continue;
+            const double v = (double)counts[i] / total_units;
+            printf("%s\"%s\": %.1f", first_counter ? "" : ", ", perf_counter_names[i], v);
+            fprintf(stderr, " %s=%.0f", perf_counter_names[i], v);
+            first_counter = false;
+        }
+        if (pc->fds[PC_CYCLES] >= 0 && pc->fds[PC_INSTRUCTIONS] >= 0 && counts[PC_CYCLES]) {
+            const double ipc = (double)counts[PC_INSTRUCTIONS] / counts[PC_CYCLES];
+            printf(", \"ipc\": %.3f", ipc);
+            fprintf(stderr, " ipc=%.2f", ipc);
+        }
+        printf("}");
+        fprintf(stderr, "\n");
+
+        if (steps > 0) {
+            printf(", \"counters_per_step\": {");
+            first_counter = true;
+            for (int i = 0; i < PC_NUM; i++) {
+                if (pc->fds[i] < 0) continue;
+                printf("%s\"%s\": %.4f", first_counter ? "" : ", ", perf_counter_names[i], counts[i] / steps);
+                first_counter = false;
+            }
+            printf("}");
+        }
+    }
+    printf("}");
+}
+
+int main(int argc, char *argv[]) {
+    int reps = 7;
+    const char *filter = NULL;
+    bool use_counters = false;
+    const char *word_list = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+            if (reps < 1) reps = 1;
+            if (reps > MAX_REPS) reps = MAX_REPS;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--counters") == 0) {
+            use_counters = true;
+        } else if (strcmp(argv[i], "--words") == 0 && i + 1 < argc) {
+            word_list = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--reps N] [--filter SUBSTR] [--counters] [--words FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    read_dawg("src/tboggle/words.dat");
+    if (word_list && !load_word_list(word_list)) {
+        fprintf(stderr, "Cannot load word list %s\n", word_list);
+        return 2;
+    }
+
+    struct bench_case cases[40];
+    int num_cases = 0;
+
+    // One solve case per dice set, each over the same rolled boards every run
+    for (int s = 0; s < num_dice_sets; s++) {
+        struct bench_case *c = &cases[num_cases++];
+        memset(c, 0, sizeof(*c));
+        snprintf(c->name, sizeof(c->name), "solve/%s", dice_sets[s].name);
+        c->unit = "ns/board";
+        c->run = run_solve;
+        c->engine = ENGINE_DAWG;
+        c->set = &dice_sets[s];
+        c->num_boards = BOARDS_PER_SOLVE_CASE;
+        c->boards = malloc(BOARDS_PER_SOLVE_CASE * sizeof(*c->boards));
+        uint64_t rng = 77 + s;
+        for (int b = 0; b < BOARDS_PER_SOLVE_CASE; b++) roll_board(c->set, &rng, c->boards[b]);
+    }
+
+    // The same boards through the interleaved batch solver
+    const int num_solve_cases = num_cases;
+    for (int s = 0; s < num_solve_cases; s++) {
+        struct bench_case *c = &cases[num_cases++];
+        *c = cases[s];
+        snprintf(c->name, sizeof(c->name), "interleaved/%s", c->set->name);
+        c->run = run_interleaved;
+        c->board_ptrs = malloc(c->num_boards * sizeof(*c->board_ptrs));
+        for (int b = 0; b < c->num_boards; b++) c->board_ptrs[b] = c->boards[b];
+    }
+
+    // And through the reverse engine
+    for (int s = 0; s < num_solve_cases; s++) {
+        struct bench_case *c = &cases[num_cases++];
+        *c = cases[s];
+        snprintf(c->name, sizeof(c->name), "reverse/%s", c->set->name);
+        c->engine = ENGINE_REVERSE;
+    }
+
+    // Board generation at increasing constraint levels; "capped" exercises
+    // the max_words fail-fast path instead of the heuristics
+    static const struct { const char *name; int min_words, max_words, min_longest, seeds; } fills[] = {
+        {"fill/low", 1, -1, 3, 10},
+        {"fill/medium", 150, -1, 8, 10},
+        {"fill/high", 200, -1, 9, 10},
+        {"fill/extreme", 250, -1, 10, 2},
+        {"fill/capped", 1, 15, 3, 10},
+    };
+    for (int f = 0; f < (int)(sizeof(fills) / sizeof(fills[0])); f++) {
+        struct bench_case *c = &cases[num_cases++];
+        memset(c, 0, sizeof(*c));
+        snprintf(c->name, sizeof(c->name), "%s", fills[f].name);
+        c->unit = "ns/board";
+        c->run = run_fill;
+        c->engine = ENGINE_DEFAULT;
+        c->min_words = fills[f].min_words;
+        c->max_words = fills[f].max_words;
+        c->min_longest = fills[f].min_longest;
+        c->seeds = fills[f].seeds;
+    }
+
+    struct perf_counters counters;
+    struct perf_counters *pc = NULL;
+    if (use_counters) {
+        if (perf_counters_open(&counters)) {
+            pc = &counters;
+            fprintf(stderr, "Hardware counters: %d of %d events available\n", counters.num_open, PC_NUM);
+        } else {
+            fprintf(stderr, "Hardware counters unavailable; reporting timing only\n");
+        }
+    }
+
+    fprintf(stderr, "Running %d repetitions per case\n", reps);
+    printf("{\n  \"suite\": \"libwords\",\n  \"reps\": %d,\n  \"counters\": %s,\n  \"cases\": [",
+           reps, pc ? "true" : "false");
+    bool first = true;
+    for (int i = 0; i < num_cases; i++) {
+        if (filter && !strstr(cases[i].name, filter)) continue;
+        measure(&cases[i], reps, first, pc);
+        first = false;
+    }
+    printf("\n  ]\n}\n");
+
+    if (pc) perf_counters_close(pc);
+    return 0;
+}
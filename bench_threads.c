@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "libwords.h"
+#include "perf_counters.h"
+
+/**
+ * THREAD-SCALING BENCHMARK
+ *
+ * Solves the golden corpus concurrently on 1, 2, 4 ... N threads (libwords
+ * built with LIBWORDS_REENTRANT, so each thread has its own solver state
+ * and only the DAWG is shared) and reports, per thread count:
+ *
+ * - boards/sec, speedup and parallel efficiency vs one thread
+ * - p50 / p99 / p99.9 per-board latency
+ * - per-thread CPU time per board, and cycles and LLC misses per board
+ *   when perf counters are available
+ *
+ * Each thread measures its own CPU time and hardware counters. If the
+ * per-board cost on N threads grows noticeably over the 1-thread cost
+ * (while threads <= cores), threads are fighting over something: shared
+ * cache lines (false sharing) or the dictionary pages. Those rows are
+ * flagged. Every solve is also checked against the corpus word count, and
+ * each thread's first pass against the corpus word hash, so a reentrancy
+ * bug shows up as a failure rather than a fast number.
+ *
+ *   ./bench_threads                  up to the number of online CPUs
+ *   ./bench_threads --threads 16     up to 16 threads
+ *   ./bench_threads --rounds 3       each thread solves the corpus 3 times
+ */
+
+#define CORPUS_PATH "golden/corpus.tsv"
+#define CONTENTION_RATIO 1.20    // Flag when per-board cost grows by 20%
+#define CACHE_LINE 64
+
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+struct board {
+    int width, height, words;
+    char dice[37];
+    uint64_t hash;           // Sum of FNV-1a 64 word hashes, as test_golden.c
+};
+
+static struct board *g_boards;
+static int g_num_boards;
+static int g_rounds = 1;
+static pthread_barrier_t g_start;
+
+/**
+ * Per-thread results, padded to a cache line each so the harness itself
+ * doesn't introduce the false sharing it is trying to detect.
+ */
+struct thread_result {
+    _Alignas(CACHE_LINE) long long boards;
+    long long mismatches;
+    double cpu_ns;
+    bool have_counters;
+    uint64_t counts[PC_NUM];
+    double *latency_ns;      // One entry per solve
+};
+
+static double now_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint64_t hash_word64(const char *word) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    while (*word) {
+        h ^= (unsigned char)*word++;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+static void load_corpus(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    int cap = 4096;
+    g_boards = malloc(cap * sizeof(*g_boards));
+    char line[256], set[32];
+    unsigned long long hash;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (g_num_boards == cap) {
+            cap *= 2;
+            g_boards = realloc(g_boards, cap * sizeof(*g_boards));
+        }
+        struct board *b = &g_boards[g_num_boards];
+        if (sscanf(line, "%31s %d %d %36s %d %*d %*d %llx",
+                   set, &b->width, &b->height, b->dice, &b->words, &hash) == 6) {
+            b->hash = hash;
+            g_num_boards++;
+        }
+    }
+    fclose(f);
+}
+
+static void *solve_worker(void *arg) {
+    struct thread_result *r = arg;
+    struct perf_counters pc;
+    r->have_counters = perf_counters_open(&pc);
+
+    pthread_barrier_wait(&g_start);
+
+    if (r->have_counters) perf_counters_start(&pc);
+    const double cpu0 = now_ns(CLOCK_THREAD_CPUTIME_ID);
+    for (int round = 0; round < g_rounds; round++) {
+        for (int i = 0; i < g_num_boards; i++) {
+            struct board *b = &g_boards[i];
+            const double t0 = now_ns(CLOCK_MONOTONIC);
+            char **words = restore_game(g_scores, b->width, b->height, b->dice);
+            r->latency_ns[r->boards] = now_ns(CLOCK_MONOTONIC) - t0;
+
+            // Hash the words once per thread; later rounds only count them
+            int n = 0;
+            uint64_t hash = 0;
+            for (; words[n]; n++) {
+                if (round == 0) hash += hash_word64(words[n]);
+            }
+            if (n != b->words || (round == 0 && hash != b->hash)) r->mismatches++;
+            r->boards++;
+        }
+    }
+    r->cpu_ns = now_ns(CLOCK_THREAD_CPUTIME_ID) - cpu0;
+    if (r->have_counters) {
+        perf_counters_stop(&pc, r->counts);
+        perf_counters_close(&pc);
+    }
+    return NULL;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    const double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+struct level {
+    int threads;
+    double boards_per_sec;
+    double cpu_ns_per_board;
+    double cycles_per_board; // < 0 when unavailable
+    double llc_per_board;    // < 0 when unavailable
+    long long mismatches;
+};
+
+static struct level run_level(int threads) {
+    pthread_t *tids = malloc(threads * sizeof(*tids));
+    struct thread_result *results = aligned_alloc(CACHE_LINE, threads * sizeof(*results));
+    const long long per_thread = (long long)g_num_boards * g_rounds;
+
+    memset(results, 0, threads * sizeof(*results));
+    pthread_barrier_init(&g_start, NULL, threads + 1);
+    for (int t = 0; t < threads; t++) {
+        results[t].latency_ns = malloc(per_thread * sizeof(double));
+        pthread_create(&tids[t], NULL, solve_worker, &results[t]);
+    }
+
+    pthread_barrier_wait(&g_start);
+    const double t0 = now_ns(CLOCK_MONOTONIC);
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    const double elapsed = now_ns(CLOCK_MONOTONIC) - t0;
+    pthread_barrier_destroy(&g_start);
+
+    // Merge per-thread latencies for the tail percentiles
+    const long long total = per_thread * threads;
+    double *all = malloc(total * sizeof(double));
+    struct level lv = {threads, 0, 0, 0, 0, 0};
+    double cpu = 0;
+    uint64_t cycles = 0, llc = 0;
+    bool have_cycles = true, have_llc = true;
+    for (int t = 0; t < threads; t++) {
+        memcpy(all + t * per_thread, results[t].latency_ns, per_thread * sizeof(double));
+        cpu += results[t].cpu_ns;
+        lv.mismatches += results[t].mismatches;
+        if (results[t].have_counters && results[t].counts[PC_CYCLES]) {
+            cycles += results[t].counts[PC_CYCLES];
+        } else {
+            have_cycles = false;
+        }
+        if (results[t].have_counters && results[t].counts[PC_LLC_MISSES]) {
+            llc += results[t].counts[PC_LLC_MISSES];
+        } else {
+            have_llc = false;
+        }
+        free(results[t].latency_ns);
+    }
+    qsort(all, total, sizeof(double), cmp_double);
+
+    lv.boards_per_sec = total / (elapsed / 1e9);
+    lv.cpu_ns_per_board = cpu / total;
+    lv.cycles_per_board = have_cycles ? (double)cycles / total : -1;
+    lv.llc_per_board = have_llc ? (double)llc / total : -1;
+
+    printf("%7d %12.0f", threads, lv.boards_per_sec);
+    printf(" %9.1f %9.1f %9.1f", all[total / 2] / 1e3, all[total * 99 / 100] / 1e3,
+           all[total * 999 / 1000] / 1e3);
+    printf(" %12.1f", lv.cpu_ns_per_board / 1e3);
+    if (lv.cycles_per_board >= 0) printf(" %10.0f", lv.cycles_per_board);
+    else printf(" %10s", "-");
+    if (lv.llc_per_board >= 0) printf(" %10.1f", lv.llc_per_board);
+    else printf(" %10s", "-");
+
+    free(all);
+    free(results);
+    free(tids);
+    return lv;
+}
+
+int main(int argc, char *argv[]) {
+    long max_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    const long cores = max_threads > 0 ? max_threads : 1;
+    const char *path = CORPUS_PATH;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            max_threads = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            g_rounds = atoi(argv[++i]);
+            if (g_rounds < 1) g_rounds = 1;
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [--threads N] [--rounds R] [corpus]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (max_threads < 1) max_threads = 1;
+
+    read_dawg("src/tboggle/words.dat");
+    load_corpus(path);
+
+    printf("Corpus: %s (%d boards x %d rounds per thread), %ld online CPUs\n\n",
+           path, g_num_boards, g_rounds, cores);
+    printf("%7s %12s %9s %9s %9s %12s %10s %10s %8s %6s\n", "threads", "boards/sec",
+           "p50 us", "p99 us", "p99.9 us", "cpu us/brd", "cyc/brd", "llc/brd", "speedup", "eff");
+
+    struct level base = {0};
+    long long mismatches = 0;
+    int flagged = 0;
+    for (long t = 1; t <= max_threads; t = (t * 2 > max_threads && t != max_threads) ? max_threads : t * 2) {
+        struct level lv = run_level((int)t);
+        if (t == 1) base = lv;
+        const double speedup = lv.boards_per_sec / base.boards_per_sec;
+        printf(" %7.2fx %5.0f%%", speedup, 100 * speedup / t);
+
+        // Per-board cost should stay flat while every thread has its own core
+        const bool cpu_grew = lv.cpu_ns_per_board > base.cpu_ns_per_board * CONTENTION_RATIO;
+        const bool llc_grew = lv.llc_per_board >= 0 && base.llc_per_board > 0 &&
+                              lv.llc_per_board > base.llc_per_board * CONTENTION_RATIO;
+        if (t > 1 && t <= cores && (cpu_grew || llc_grew)) {
+            printf("  <- %s grew: contention/false sharing?", llc_grew ? "LLC misses" : "CPU/board");
+            flagged++;
+        } else if (t > cores) {
+            printf("  (oversubscribed)");
+        }
+        printf("\n");
+        mismatches += lv.mismatches;
+    }
+
+    if (mismatches) {
+        printf("\nFAILED: %lld solves disagreed with the corpus (solver state shared between threads?)\n",
+               mismatches);
+        return 1;
+    }
+    if (flagged) printf("\n%d thread count(s) flagged for shared-state contention\n", flagged);
+    return 0;
+}
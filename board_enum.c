@@ -0,0 +1,481 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "dice_sets.h"
+#include "libwords.h"
+
+/**
+ * EXHAUSTIVE BOARD ENUMERATION
+ *
+ * Walks every distinct board a small dice set can roll and writes the exact
+ * distributions of word count, score and longest word, in the board_stats
+ * format (with "exact 1" in the header), so the same readers work on it.
+ *
+ *   ./board_enum --dice AAEEGN,ELRTTY,AOOTTW,ABBJOO
+ *   ./board_enum --dice ... --min-legal 4 --verify -o exact2x2.txt
+ *
+ * A board is rolled by placing the n dice in random order and picking one
+ * of six faces per die, so there are n! * 6^n equally likely outcomes. The
+ * enumeration shrinks that in three ways:
+ *
+ * - Identical dice (same faces in any order) are one die type; only the
+ *   distinct arrangements of types are walked.
+ * - Arrangements that are rotations/reflections of each other have the same
+ *   words, so only the lexicographically smallest of each orbit is walked,
+ *   weighted by the orbit size.
+ * - Repeated faces on a die are walked once, weighted by their count.
+ *
+ * Face choices for an arrangement are walked in reflected mixed-radix Gray
+ * code order (Knuth's Algorithm H), so consecutive boards differ in exactly
+ * one tile, and each step is an incr_change() of that tile instead of a
+ * full solve. Arrangements are shared out to threads; per-thread tallies are
+ * summed at the end. Counts are outcome weights out of
+ * (distinct arrangements) * 6^n; that total is the "boards" field.
+ *
+ * --verify re-solves every board with solve_board() and checks the
+ * incremental totals; --limit refuses enumerations that would visit more
+ * boards than that (default 10^8). A 3x3 of nine distinct dice is around
+ * 10^11 boards, so it needs a raised --limit and a long run.
+ */
+
+#define MAX_WORDS_VALUE 4096     // Exact histogram sizes; larger values clamp
+#define MAX_SCORE_VALUE 65536
+#define JOINT_BINS 128
+#define MAX_ENUM_DICE 25
+#define NUM_SYMMETRIES 8
+
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+static const double quantiles[] = {0.01, 0.05, 0.10, 0.25, 0.50, 0.75, 0.90, 0.95, 0.99};
+#define NUM_QUANTILES (int)(sizeof(quantiles) / sizeof(quantiles[0]))
+
+typedef unsigned long long weight_t;
+
+struct tally {
+    weight_t words[MAX_WORDS_VALUE];
+    weight_t score[MAX_SCORE_VALUE];
+    weight_t longest[MAX_WORD_LEN + 1];
+    weight_t joint[JOINT_BINS][JOINT_BINS][MAX_WORD_LEN + 1];
+    long long boards;        // Boards actually solved
+    long long mismatches;    // --verify failures
+};
+
+// A die type: identical dice collapse into one, with distinct faces and counts
+struct die_type {
+    char faces[7];
+    int num_faces;
+    char face[6];
+    int face_count[6];
+    int copies;
+};
+
+struct arrangement {
+    unsigned char type[MAX_ENUM_DICE];
+    int orbit;
+};
+
+static struct die_type g_types[MAX_ENUM_DICE];
+static int g_num_types;
+static int g_num_dice, g_size;
+static int g_min_legal = 3;
+static int g_words_bin, g_score_bin;
+static bool g_verify;
+static int g_sym[NUM_SYMMETRIES][MAX_ENUM_DICE];    // Position p maps to g_sym[s][p]
+
+static struct arrangement *g_arrs;
+static long long g_num_arrs, g_cap_arrs;
+static long long g_boards_per_arr;
+static atomic_llong g_next_arr;
+static atomic_llong g_done;
+
+static inline int clamp(int v, int max) {
+    return v < max ? v : max - 1;
+}
+
+static int cmp_char(const void *a, const void *b) {
+    return *(const char *)a - *(const char *)b;
+}
+
+/**
+ * Parse a comma-separated list of six-face dice into die types.
+ */
+static bool parse_dice(const char *spec) {
+    char buf[512];
+    snprintf(buf, sizeof(buf), "%s", spec);
+    g_num_dice = 0;
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+        if (strlen(tok) != 6 || g_num_dice == MAX_ENUM_DICE) return false;
+        char faces[7];
+        memcpy(faces, tok, 7);
+        for (int f = 0; f < 6; f++) {
+            if (!((faces[f] >= 'A' && faces[f] <= 'Z') || (faces[f] >= '0' && faces[f] <= '6'))) return false;
+        }
+        qsort(faces, 6, 1, cmp_char);
+        g_num_dice++;
+
+        int t = 0;
+        while (t < g_num_types && strcmp(g_types[t].faces, faces) != 0) t++;
+        if (t == g_num_types) {
+            struct die_type *dt = &g_types[g_num_types++];
+            memcpy(dt->faces, faces, 7);
+            for (int f = 0; f < 6; f++) {
+                if (dt->num_faces && dt->face[dt->num_faces - 1] == faces[f]) {
+                    dt->face_count[dt->num_faces - 1]++;
+                } else {
+                    dt->face[dt->num_faces] = faces[f];
+                    dt->face_count[dt->num_faces++] = 1;
+                }
+            }
+        }
+        g_types[t].copies++;
+    }
+    return true;
+}
+
+/**
+ * The 8 symmetries of a square board: optional transpose, then optional
+ * flips of each axis.
+ */
+static void build_symmetries(void) {
+    const int n = g_size;
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        for (int y = 0; y < n; y++) {
+            for (int x = 0; x < n; x++) {
+                int sy = (s & 4) ? x : y, sx = (s & 4) ? y : x;
+                if (s & 1) sx = n - 1 - sx;
+                if (s & 2) sy = n - 1 - sy;
+                g_sym[s][y * n + x] = sy * n + sx;
+            }
+        }
+    }
+}
+
+/**
+ * Keep an arrangement if no symmetric image of it is lexicographically
+ * smaller; its orbit size is 8 / (number of symmetries that fix it).
+ */
+static void consider(const unsigned char *type) {
+    int fixed = 0;
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        int c = 0;
+        for (int p = 0; p < g_num_dice && c == 0; p++) c = type[g_sym[s][p]] - type[p];
+        if (c < 0) return;
+        if (c == 0) fixed++;
+    }
+    if (g_num_arrs == g_cap_arrs) {
+        g_cap_arrs = g_cap_arrs ? g_cap_arrs * 2 : 1024;
+        g_arrs = realloc(g_arrs, g_cap_arrs * sizeof(*g_arrs));
+        if (!g_arrs) {
+            fprintf(stderr, "Out of memory\n");
+            exit(2);
+        }
+    }
+    memcpy(g_arrs[g_num_arrs].type, type, g_num_dice);
+    g_arrs[g_num_arrs++].orbit = NUM_SYMMETRIES / fixed;
+}
+
+static void arrange(unsigned char *type, int pos, int *left) { // NOLINT(*-no-recursion)
+    if (pos == g_num_dice) {
+        consider(type);
+        return;
+    }
+    for (int t = 0; t < g_num_types; t++) {
+        if (!left[t]) continue;
+        left[t]--;
+        type[pos] = t;
+        arrange(type, pos + 1, left);
+        left[t]++;
+    }
+}
+
+static void tally_board(struct tally *t, const struct board_totals *r, weight_t weight) {
+    t->words[clamp(r->words, MAX_WORDS_VALUE)] += weight;
+    t->score[clamp(r->score, MAX_SCORE_VALUE)] += weight;
+    t->longest[r->longest] += weight;
+    t->joint[clamp(r->words / g_words_bin, JOINT_BINS)]
+            [clamp(r->score / g_score_bin, JOINT_BINS)][r->longest] += weight;
+    t->boards++;
+}
+
+static void verify_board(struct tally *t, const char *dice, const struct board_totals *r) {
+    struct board_totals full;
+    solve_board(g_scores, g_size, g_size, dice, g_min_legal, &full);
+    if (full.words != r->words || full.score != r->score || full.longest != r->longest) {
+        if (t->mismatches++ < 10) {
+            fprintf(stderr, "MISMATCH %s: incremental %d/%d/%d, full %d/%d/%d\n", dice,
+                    r->words, r->score, r->longest, full.words, full.score, full.longest);
+        }
+    }
+}
+
+/**
+ * Walk every face choice of one arrangement in reflected Gray code order.
+ */
+static void enumerate_faces(struct tally *t, const struct arrangement *arr) {
+    const int n = g_num_dice;
+    char dice[MAX_ENUM_DICE + 1];
+    int pos[MAX_ENUM_DICE];          // Gray code digit j -> board position
+    int radix[MAX_ENUM_DICE];
+    int digit[MAX_ENUM_DICE], dir[MAX_ENUM_DICE], focus[MAX_ENUM_DICE + 1];
+    int m = 0;
+    weight_t weight = arr->orbit;
+
+    for (int p = 0; p < n; p++) {
+        const struct die_type *dt = &g_types[arr->type[p]];
+        dice[p] = dt->face[0];
+        weight *= dt->face_count[0];
+        if (dt->num_faces > 1) {
+            pos[m] = p;
+            radix[m] = dt->num_faces;
+            digit[m] = 0;
+            dir[m] = 1;
+            focus[m] = m;
+            m++;
+        }
+    }
+    dice[n] = '\0';
+    focus[m] = m;
+
+    struct board_totals r;
+    incr_start(g_scores, g_size, g_size, dice, g_min_legal, &r);
+    for (;;) {
+        tally_board(t, &r, weight);
+        if (g_verify) verify_board(t, dice, &r);
+
+        // Knuth, TAOCP 7.2.1.1 Algorithm H (loopless reflected mixed-radix Gray)
+        const int j = focus[0];
+        focus[0] = 0;
+        if (j == m) break;
+        const struct die_type *dt = &g_types[arr->type[pos[j]]];
+        weight /= dt->face_count[digit[j]];
+        digit[j] += dir[j];
+        weight *= dt->face_count[digit[j]];
+        if (digit[j] == 0 || digit[j] == radix[j] - 1) {
+            dir[j] = -dir[j];
+            focus[j] = focus[j + 1];
+            focus[j + 1] = j + 1;
+        }
+        dice[pos[j]] = dt->face[digit[j]];
+        incr_change(pos[j], dice[pos[j]], &r);
+    }
+}
+
+static void *enum_worker(void *arg) {
+    struct tally *t = arg;
+    for (;;) {
+        const long long a = atomic_fetch_add_explicit(&g_next_arr, 1, memory_order_relaxed);
+        if (a >= g_num_arrs) break;
+        enumerate_faces(t, &g_arrs[a]);
+        atomic_fetch_add_explicit(&g_done, g_boards_per_arr, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void merge(struct tally *into, const struct tally *t) {
+    for (int v = 0; v < MAX_WORDS_VALUE; v++) into->words[v] += t->words[v];
+    for (int v = 0; v < MAX_SCORE_VALUE; v++) into->score[v] += t->score[v];
+    for (int v = 0; v <= MAX_WORD_LEN; v++) into->longest[v] += t->longest[v];
+    weight_t *dst = &into->joint[0][0][0];
+    const weight_t *src = &t->joint[0][0][0];
+    for (size_t k = 0; k < sizeof(t->joint) / sizeof(weight_t); k++) dst[k] += src[k];
+    into->boards += t->boards;
+    into->mismatches += t->mismatches;
+}
+
+static void write_quantiles(FILE *out, const char *name, const weight_t *hist, int size, weight_t total) {
+    fprintf(out, "q_%s", name);
+    weight_t seen = 0;
+    int v = 0;
+    for (int q = 0; q < NUM_QUANTILES; q++) {
+        const weight_t rank = (weight_t)(quantiles[q] * (total - 1));
+        while (v < size - 1 && seen + hist[v] <= rank) seen += hist[v++];
+        fprintf(out, " %d", v);
+    }
+    fprintf(out, "\n");
+}
+
+static void write_histogram(FILE *out, const char *name, const weight_t *hist, int size) {
+    fprintf(out, "%s", name);
+    for (int v = 0; v < size; v++) {
+        if (hist[v]) fprintf(out, " %d:%llu", v, hist[v]);
+    }
+    fprintf(out, "\n");
+}
+
+static void write_stats(FILE *out, const char *name, const struct tally *t, weight_t total) {
+    long double mean_words = 0, mean_score = 0, mean_longest = 0;
+    for (int v = 0; v < MAX_WORDS_VALUE; v++) mean_words += (long double)v * t->words[v];
+    for (int v = 0; v < MAX_SCORE_VALUE; v++) mean_score += (long double)v * t->score[v];
+    for (int v = 0; v <= MAX_WORD_LEN; v++) mean_longest += (long double)v * t->longest[v];
+
+    fprintf(out, "# board_stats v1\n");
+    fprintf(out, "set %s size %d boards %llu seed 0 min_legal %d words_bin %d score_bin %d exact 1\n",
+            name, g_size, total, g_min_legal, g_words_bin, g_score_bin);
+    fprintf(out, "mean %.6Lf %.6Lf %.6Lf\n", mean_words / total, mean_score / total,
+            mean_longest / total);
+    fprintf(out, "quantiles");
+    for (int q = 0; q < NUM_QUANTILES; q++) fprintf(out, " %.2f", quantiles[q]);
+    fprintf(out, "\n");
+    write_quantiles(out, "words", t->words, MAX_WORDS_VALUE, total);
+    write_quantiles(out, "score", t->score, MAX_SCORE_VALUE, total);
+    write_quantiles(out, "longest", t->longest, MAX_WORD_LEN + 1, total);
+    write_histogram(out, "words", t->words, MAX_WORDS_VALUE);
+    write_histogram(out, "score", t->score, MAX_SCORE_VALUE);
+    write_histogram(out, "longest", t->longest, MAX_WORD_LEN + 1);
+
+    fprintf(out, "joint");
+    for (int w = 0; w < JOINT_BINS; w++) {
+        for (int s = 0; s < JOINT_BINS; s++) {
+            for (int l = 0; l <= MAX_WORD_LEN; l++) {
+                if (t->joint[w][s][l]) fprintf(out, " %d:%d:%d:%llu", w, s, l, t->joint[w][s][l]);
+            }
+        }
+    }
+    fprintf(out, "\nend\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *spec = NULL, *out_path = NULL, *name = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    double limit = 1e8;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (strcmp(a, "--verify") == 0) {
+            g_verify = true;
+            continue;
+        }
+        if (i + 1 >= argc) goto usage;
+        if (strcmp(a, "--dice") == 0) spec = argv[++i];
+        else if (strcmp(a, "--name") == 0) name = argv[++i];
+        else if (strcmp(a, "--threads") == 0) threads = atol(argv[++i]);
+        else if (strcmp(a, "--min-legal") == 0) g_min_legal = atoi(argv[++i]);
+        else if (strcmp(a, "--limit") == 0) limit = atof(argv[++i]);
+        else if (strcmp(a, "-o") == 0) out_path = argv[++i];
+        else goto usage;
+    }
+    if (!spec) goto usage;
+    if (threads < 1) threads = 1;
+    if (!parse_dice(spec)) {
+        fprintf(stderr, "Dice must be comma-separated, six faces each (A-Z, 0-6), at most %d\n",
+                MAX_ENUM_DICE);
+        return 2;
+    }
+    for (g_size = 1; g_size * g_size < g_num_dice; g_size++) {}
+    if (g_size * g_size != g_num_dice) {
+        fprintf(stderr, "Need a square number of dice, got %d\n", g_num_dice);
+        return 2;
+    }
+
+    // Size up the walk before doing it: distinct arrangements, /8 for
+    // symmetry, times distinct face choices per arrangement. Few orbits are
+    // smaller than 8, so this is only a lower bound, enough to refuse a
+    // hopeless walk before arrange() lists it; the exact count is checked
+    // once the orbits are known
+    double arrangements = 1, faces = 1;
+    for (int k = 2; k <= g_num_dice; k++) arrangements *= k;
+    for (int t = 0; t < g_num_types; t++) {
+        for (int k = 2; k <= g_types[t].copies; k++) arrangements /= k;
+        for (int c = 0; c < g_types[t].copies; c++) faces *= g_types[t].num_faces;
+    }
+    const double at_least = arrangements / NUM_SYMMETRIES * faces;
+    fprintf(stderr, "%d dice, %d distinct, %.0f arrangements, %.0f face choices\n",
+            g_num_dice, g_num_types, arrangements, faces);
+    if (at_least > limit) {
+        fprintf(stderr, "Too many boards for --limit %.3g: at least %.3g\n", limit, at_least);
+        return 2;
+    }
+    // Weights must fit: the total is (distinct arrangements) * 6^n
+    weight_t total = 1;
+    for (int k = 0; k < g_num_dice; k++) {
+        if (__builtin_mul_overflow(total, (weight_t)6, &total)) goto too_big;
+    }
+    if (__builtin_mul_overflow(total, (weight_t)arrangements, &total)) goto too_big;
+
+    read_dawg("src/tboggle/words.dat");
+    incr_init();
+    build_symmetries();
+    g_words_bin = 1 << (g_size > 2 ? g_size - 2 : 0);
+    g_score_bin = 2 * g_words_bin;
+    g_boards_per_arr = (long long)faces;
+
+    unsigned char type[MAX_ENUM_DICE];
+    int left[MAX_ENUM_DICE];
+    for (int t = 0; t < g_num_types; t++) left[t] = g_types[t].copies;
+    arrange(type, 0, left);
+
+    const long long visits = g_num_arrs * g_boards_per_arr;
+    if (visits > limit) {
+        fprintf(stderr, "Too many boards for --limit %.3g: %lld\n", limit, visits);
+        return 2;
+    }
+    pthread_t *tids = malloc(threads * sizeof(*tids));
+    struct tally **tallies = malloc(threads * sizeof(*tallies));
+    const double t0 = now_sec();
+    for (int t = 0; t < threads; t++) {
+        tallies[t] = calloc(1, sizeof(struct tally));
+        if (!tallies[t]) {
+            fprintf(stderr, "Out of memory\n");
+            return 2;
+        }
+        pthread_create(&tids[t], NULL, enum_worker, tallies[t]);
+    }
+    long long done;
+    while ((done = atomic_load_explicit(&g_done, memory_order_relaxed)) < visits) {
+        const double elapsed = now_sec() - t0;
+        if (elapsed > 0) {
+            fprintf(stderr, "\r%12lld/%lld boards  %9.0f boards/s", done, visits, done / elapsed);
+        }
+        struct timespec pause = {0, 250 * 1000 * 1000};
+        nanosleep(&pause, NULL);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    const double elapsed = now_sec() - t0;
+    for (int t = 1; t < threads; t++) {
+        merge(tallies[0], tallies[t]);
+        free(tallies[t]);
+    }
+    fprintf(stderr, "\r%12lld/%lld boards  %9.0f boards/s  %.1fs (%lld arrangements after symmetry)\n",
+            tallies[0]->boards, visits, tallies[0]->boards / elapsed, elapsed, g_num_arrs);
+
+    FILE *out = stdout;
+    if (out_path && !(out = fopen(out_path, "w"))) {
+        perror(out_path);
+        return 2;
+    }
+    char default_name[32];
+    snprintf(default_name, sizeof(default_name), "custom-%dx%d", g_size, g_size);
+    write_stats(out, name ? name : default_name, tallies[0], total);
+    if (out != stdout) fclose(out);
+
+    if (g_verify) {
+        if (tallies[0]->mismatches) {
+            fprintf(stderr, "FAILED: %lld boards differ from a full solve\n", tallies[0]->mismatches);
+            return 1;
+        }
+        fprintf(stderr, "OK: %lld incremental solves match full solves\n", tallies[0]->boards);
+    }
+    return 0;
+
+too_big:
+    fprintf(stderr, "Too many outcomes to count exactly in 64 bits\n");
+    return 2;
+
+usage:
+    fprintf(stderr, "usage: %s --dice D1,D2,... [--name NAME] [--threads N] [--min-legal N] "
+            "[--limit N] [--verify] [-o FILE]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "dice_sets.h"
+#include "libwords.h"
+
+/**
+ * MONTE-CARLO BOARD STATISTICS
+ *
+ * Solves many random boards per dice set (on all cores; libwords built
+ * with LIBWORDS_REENTRANT) and writes the distributions of word count,
+ * score and longest word: exact histograms, quantiles, and the joint
+ * (words, score, longest) distribution in coarse bins. chooser.py defaults,
+ * fill_board feasibility estimates and board-bank sizing all read this file
+ * through src/tboggle/board_stats.py.
+ *
+ *   ./board_stats --boards 1000000 -o board_stats.txt        every set
+ *   ./board_stats --set 5 --min-legal 4 --boards 200000
+ *
+ * Board i of a set is rolled from its own RNG stream derived from --seed,
+ * the set and i, and per-thread tallies are summed at the end, so the
+ * output depends only on the options, never on --threads or scheduling.
+ *
+ * OUTPUT (sparse text, one block per set; values are "value:count"):
+ *
+ *   set <name> size <n> boards <N> seed <s> min_legal <m> words_bin <w> score_bin <b>
+ *   mean <words> <score> <longest>
+ *   quantiles 0.01 0.05 0.10 0.25 0.50 0.75 0.90 0.95 0.99
+ *   q_words ... / q_score ... / q_longest ...
+ *   words v:c ... / score v:c ... / longest v:c ...
+ *   joint wbin:sbin:longest:count ...    bin = value / bin width, last bin open-ended
+ *   end
+ */
+
+#define MAX_WORDS_VALUE 4096     // Exact histogram sizes; larger values clamp
+#define MAX_SCORE_VALUE 65536
+#define JOINT_BINS 128
+#define CHUNK 256                // Boards claimed per trip to the shared counter
+#define CACHE_LINE 64
+
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+static const double quantiles[] = {0.01, 0.05, 0.10, 0.25, 0.50, 0.75, 0.90, 0.95, 0.99};
+#define NUM_QUANTILES (int)(sizeof(quantiles) / sizeof(quantiles[0]))
+
+struct tally {
+    long long words[MAX_WORDS_VALUE];
+    long long score[MAX_SCORE_VALUE];
+    long long longest[MAX_WORD_LEN + 1];
+    long long joint[JOINT_BINS][JOINT_BINS][MAX_WORD_LEN + 1];
+};
+
+// Shared, read-only while workers run (except the two counters)
+static const struct dice_set *g_set;
+static int g_set_index;
+static long long g_boards;
+static uint64_t g_seed;
+static int g_min_legal = 3;
+static int g_words_bin, g_score_bin;
+static _Alignas(CACHE_LINE) atomic_llong g_next;
+static _Alignas(CACHE_LINE) atomic_llong g_done;
+
+static inline int clamp(int v, int max) {
+    return v < max ? v : max - 1;
+}
+
+static void *stats_worker(void *arg) {
+    struct tally *t = arg;
+    char dice[CHUNK][MAX_DICE + 1];
+    const char *boards[CHUNK];
+    struct board_totals totals[CHUNK];
+    const int n = g_set->num;
+
+    for (int b = 0; b < CHUNK; b++) boards[b] = dice[b];
+    for (;;) {
+        const long long start = atomic_fetch_add_explicit(&g_next, CHUNK, memory_order_relaxed);
+        if (start >= g_boards) break;
+        const long long end = start + CHUNK < g_boards ? start + CHUNK : g_boards;
+
+        // Roll the chunk, then solve it as one interleaved batch
+        for (long long i = start; i < end; i++) {
+            uint64_t rng = g_seed << 32 ^ (uint64_t)g_set_index << 56 ^ (uint64_t)i;
+            roll_board(g_set, &rng, dice[i - start]);
+        }
+        solve_boards(g_scores, n, n, boards, end - start, g_min_legal, totals, NULL);
+        for (int b = 0; b < end - start; b++) {
+            const struct board_totals r = totals[b];
+            t->words[clamp(r.words, MAX_WORDS_VALUE)]++;
+            t->score[clamp(r.score, MAX_SCORE_VALUE)]++;
+            t->longest[r.longest]++;
+            t->joint[clamp(r.words / g_words_bin, JOINT_BINS)]
+                    [clamp(r.score / g_score_bin, JOINT_BINS)][r.longest]++;
+        }
+        atomic_fetch_add_explicit(&g_done, end - start, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void merge(struct tally *into, const struct tally *t) {
+    for (int v = 0; v < MAX_WORDS_VALUE; v++) into->words[v] += t->words[v];
+    for (int v = 0; v < MAX_SCORE_VALUE; v++) into->score[v] += t->score[v];
+    for (int v = 0; v <= MAX_WORD_LEN; v++) into->longest[v] += t->longest[v];
+    long long *dst = &into->joint[0][0][0];
+    const long long *src = &t->joint[0][0][0];
+    for (size_t k = 0; k < sizeof(t->joint) / sizeof(long long); k++) dst[k] += src[k];
+}
+
+static void write_quantiles(FILE *out, const char *name, const long long *hist, int size, long long total) {
+    fprintf(out, "q_%s", name);
+    long long seen = 0;
+    int v = 0;
+    for (int q = 0; q < NUM_QUANTILES; q++) {
+        const long long rank = (long long)(quantiles[q] * (total - 1));
+        while (v < size - 1 && seen + hist[v] <= rank) seen += hist[v++];
+        fprintf(out, " %d", v);
+    }
+    fprintf(out, "\n");
+}
+
+static void write_histogram(FILE *out, const char *name, const long long *hist, int size) {
+    fprintf(out, "%s", name);
+    for (int v = 0; v < size; v++) {
+        if (hist[v]) fprintf(out, " %d:%lld", v, hist[v]);
+    }
+    fprintf(out, "\n");
+}
+
+static void write_set(FILE *out, const struct tally *t) {
+    double mean_words = 0, mean_score = 0, mean_longest = 0;
+    for (int v = 0; v < MAX_WORDS_VALUE; v++) mean_words += (double)v * t->words[v];
+    for (int v = 0; v < MAX_SCORE_VALUE; v++) mean_score += (double)v * t->score[v];
+    for (int v = 0; v <= MAX_WORD_LEN; v++) mean_longest += (double)v * t->longest[v];
+
+    fprintf(out, "set %s size %d boards %lld seed %llu min_legal %d words_bin %d score_bin %d\n",
+            g_set->name, g_set->num, g_boards, (unsigned long long)g_seed, g_min_legal,
+            g_words_bin, g_score_bin);
+    fprintf(out, "mean %.3f %.3f %.3f\n", mean_words / g_boards, mean_score / g_boards,
+            mean_longest / g_boards);
+    fprintf(out, "quantiles");
+    for (int q = 0; q < NUM_QUANTILES; q++) fprintf(out, " %.2f", quantiles[q]);
+    fprintf(out, "\n");
+    write_quantiles(out, "words", t->words, MAX_WORDS_VALUE, g_boards);
+    write_quantiles(out, "score", t->score, MAX_SCORE_VALUE, g_boards);
+    write_quantiles(out, "longest", t->longest, MAX_WORD_LEN + 1, g_boards);
+    write_histogram(out, "words", t->words, MAX_WORDS_VALUE);
+    write_histogram(out, "score", t->score, MAX_SCORE_VALUE);
+    write_histogram(out, "longest", t->longest, MAX_WORD_LEN + 1);
+
+    fprintf(out, "joint");
+    for (int w = 0; w < JOINT_BINS; w++) {
+        for (int s = 0; s < JOINT_BINS; s++) {
+            for (int l = 0; l <= MAX_WORD_LEN; l++) {
+                if (t->joint[w][s][l]) fprintf(out, " %d:%d:%d:%lld", w, s, l, t->joint[w][s][l]);
+            }
+        }
+    }
+    fprintf(out, "\nend\n");
+}
+
+static void run_set(FILE *out, int threads) {
+    pthread_t *tids = malloc(threads * sizeof(*tids));
+    struct tally **tallies = malloc(threads * sizeof(*tallies));
+
+    atomic_store(&g_next, 0);
+    atomic_store(&g_done, 0);
+    const double t0 = now_sec();
+    for (int t = 0; t < threads; t++) {
+        tallies[t] = calloc(1, sizeof(struct tally));
+        if (!tallies[t]) {
+            fprintf(stderr, "Out of memory\n");
+            exit(2);
+        }
+        pthread_create(&tids[t], NULL, stats_worker, tallies[t]);
+    }
+
+    // Progress on stderr while the workers run
+    long long done;
+    while ((done = atomic_load_explicit(&g_done, memory_order_relaxed)) < g_boards) {
+        const double elapsed = now_sec() - t0;
+        if (elapsed > 0) {
+            fprintf(stderr, "\rset %-12s %12lld/%lld boards  %9.0f boards/s", g_set->name, done,
+                    g_boards, done / elapsed);
+        }
+        struct timespec pause = {0, 250 * 1000 * 1000};
+        nanosleep(&pause, NULL);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    const double elapsed = now_sec() - t0;
+    fprintf(stderr, "\rset %-12s %12lld/%lld boards  %9.0f boards/s  %.1fs\n", g_set->name, g_boards,
+            g_boards, g_boards / elapsed, elapsed);
+
+    for (int t = 1; t < threads; t++) {
+        merge(tallies[0], tallies[t]);
+        free(tallies[t]);
+    }
+    write_set(out, tallies[0]);
+    free(tallies[0]);
+    free(tallies);
+    free(tids);
+}
+
+int main(int argc, char *argv[]) {
+    const char *set_name = NULL;
+    const char *out_path = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int words_bin = 0, score_bin = 0;
+    g_boards = 100000;
+    g_seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (i + 1 >= argc) goto usage;
+        if (strcmp(a, "--set") == 0) set_name = argv[++i];
+        else if (strcmp(a, "--boards") == 0) g_boards = atoll(argv[++i]);
+        else if (strcmp(a, "--threads") == 0) threads = atol(argv[++i]);
+        else if (strcmp(a, "--seed") == 0) g_seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(a, "--min-legal") == 0) g_min_legal = atoi(argv[++i]);
+        else if (strcmp(a, "--words-bin") == 0) words_bin = atoi(argv[++i]);
+        else if (strcmp(a, "--score-bin") == 0) score_bin = atoi(argv[++i]);
+        else if (strcmp(a, "-o") == 0) out_path = argv[++i];
+        else goto usage;
+    }
+    if (threads < 1) threads = 1;
+    if (g_boards < 1) goto usage;
+
+    FILE *out = stdout;
+    if (out_path && !(out = fopen(out_path, "w"))) {
+        perror(out_path);
+        return 2;
+    }
+
+    read_dawg("src/tboggle/words.dat");
+    fprintf(out, "# board_stats v1\n");
+
+    bool found = false;
+    for (int s = 0; s < num_dice_sets; s++) {
+        if (set_name && strcmp(set_name, dice_sets[s].name) != 0) continue;
+        found = true;
+        g_set = &dice_sets[s];
+        g_set_index = s;
+        // Joint bins scale with board size: 4/8/16 words and 8/16/32 points
+        // for 4x4/5x5/6x6 cover every board seen in the golden corpus
+        g_words_bin = words_bin > 0 ? words_bin : 1 << (g_set->num - 2);
+        g_score_bin = score_bin > 0 ? score_bin : 2 << (g_set->num - 2);
+        run_set(out, (int)threads);
+    }
+    if (!found) {
+        fprintf(stderr, "Unknown dice set: %s\n", set_name);
+        return 2;
+    }
+    if (out != stdout) fclose(out);
+    return 0;
+
+usage:
+    fprintf(stderr, "usage: %s [--set NAME] [--boards N] [--threads N] [--seed N] [--min-legal N] "
+            "[--words-bin N] [--score-bin N] [-o FILE]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""
+Compile all.sqlite3 definitions into a memory-mapped definition store and
+a reverse-lookup index over the words of the definitions.
+
+    python3 build_defs.py [--db src/tboggle/all.sqlite3] [--dawg src/tboggle/words.dat]
+                          [-o src/tboggle/defs.dat] [--index src/tboggle/defs_index.dat]
+
+libwords looks definitions up by word ID (the word's rank in DAWG order),
+so the store is laid out by ID: definitions are NUL-terminated, grouped in
+blocks of DEF_BLOCK_WORDS consecutive IDs, and each block is raw-deflated
+on its own with a shared preset dictionary. A lookup inflates one block of
+a few hundred bytes (about 4us; 64-word blocks pack 20% smaller but take
+four times as long). Layout (see struct def_store_header in libwords.h):
+
+    header | uint32 block offsets [num_blocks + 1] | dictionary | blocks
+
+zlib stands in for zstd (not available everywhere we build); the preset
+dictionary plays the role of zstd's trained dictionary and is "trained"
+the simple way: the most frequent 1-3 token phrases, weighted by the bytes
+they would save, with the most valuable placed last where deflate's
+distances are shortest.
+
+The index (see struct def_index_header in libwords.h) maps each token of
+the definitions' text to its posting list, the word IDs whose definition
+contains it:
+
+    header | uint32 token offsets [num_tokens + 1]
+           | uint32 posting offsets [num_tokens + 1] | tokens | postings
+
+Tokens are sorted, so a prefix is a binary-searched range. A posting is a
+varint ID delta followed by one byte, the token's first position among
+the definition's indexed tokens (capped at 255), which libwords uses for
+ranking. Inflection pointers (<abuse=v>), the bracketed part of speech
+and inflections, one-letter tokens and STOP_WORDS are not indexed.
+"""
+import argparse
+import array
+import collections
+import re
+import sqlite3
+import struct
+import sys
+import zlib
+
+MAGIC = b"LWDEFS1\0"
+DEF_BLOCK_WORDS = 16     # struct def_store_header.block_words
+DEF_BLOCK_MAX = 32768    # libwords.h: largest inflated block
+DICT_SIZE = 32768        # deflate window
+HEADER = struct.Struct("<8sIIIIII")
+
+INDEX_MAGIC = b"LWDIDX1\0"
+INDEX_HEADER = struct.Struct("<8sIIII")
+STOP_WORDS = {"an", "and", "as", "at", "be", "by", "for", "in", "into", "is", "it", "of", "on", "or",
+              "that", "the", "to", "with"}
+
+CHILD_SHIFT, EOW, EOL, LETTER = 10, 0x200, 0x100, 0xFF
+
+
+def dawg_words(path: str) -> list[str]:
+    """Words of a words.dat DAWG in DAWG (= word ID) order."""
+    nodes = array.array("i")
+    with open(path, "rb") as f:
+        nodes.frombytes(f.read())
+    if sys.byteorder != "little":
+        nodes.byteswap()
+    words = []
+
+    def walk(i: int, prefix: str) -> None:
+        while i:
+            node = nodes[i + 1]    # read_dawg() skips the leading count
+            word = prefix + chr(node & LETTER)
+            if node & EOW:
+                words.append(word)
+            walk(node >> CHILD_SHIFT, word)
+            i = 0 if node & EOL else i + 1
+
+    walk(1, "")
+    return words
+
+
+def train_dictionary(defs: list[bytes], size: int = DICT_SIZE) -> bytes:
+    phrases = collections.Counter()
+    for d in defs[::7]:
+        tokens = d.split(b" ")
+        for n in (1, 2, 3):
+            for i in range(len(tokens) - n + 1):
+                phrases[b" ".join(tokens[i:i + n])] += 1
+    ranked = sorted(phrases.items(), key=lambda kv: (kv[1] - 1) * len(kv[0]), reverse=True)
+    chosen, used = [], 0
+    for phrase, _ in ranked:
+        if used + len(phrase) + 1 > size:
+            continue
+        chosen.append(phrase)
+        used += len(phrase) + 1
+    return b" ".join(reversed(chosen))
+
+
+def index_tokens(definition: str) -> list[str]:
+    """Indexed tokens of a definition, in order (libwords tokenizes queries the same way)."""
+    text = re.sub(r"<[^>]*>|\[[^\]]*\]|=[a-z]+", " ", definition.lower())
+    return [t for t in re.findall(r"[a-z]+", text) if len(t) > 1 and t not in STOP_WORDS]
+
+
+def varint(n: int) -> bytes:
+    out = bytearray()
+    while n >= 0x80:
+        out.append(n & 0x7F | 0x80)
+        n >>= 7
+    out.append(n)
+    return bytes(out)
+
+
+def write_index(path: str, definitions: list[str]) -> None:
+    postings = collections.defaultdict(list)
+    for word_id, definition in enumerate(definitions):
+        first = {}
+        for pos, token in enumerate(index_tokens(definition)):
+            first.setdefault(token, min(pos, 255))
+        for token, pos in first.items():
+            postings[token].append((word_id, pos))
+
+    tokens = sorted(postings, key=lambda t: t.encode())
+    token_offsets, posting_offsets = [0], [0]
+    token_blob, posting_blob = bytearray(), bytearray()
+    for token in tokens:
+        token_blob += token.encode()
+        token_offsets.append(len(token_blob))
+        last = 0
+        for word_id, pos in postings[token]:
+            posting_blob += varint(word_id - last)
+            posting_blob.append(pos)
+            last = word_id
+        posting_offsets.append(len(posting_blob))
+    token_blob += b"\0" * (-len(token_blob) % 4)
+
+    header = INDEX_HEADER.pack(INDEX_MAGIC, len(definitions), len(tokens), len(token_blob), len(posting_blob))
+    with open(path, "wb") as out:
+        out.write(header)
+        out.write(struct.pack(f"<{len(tokens) + 1}I", *token_offsets))
+        out.write(struct.pack(f"<{len(tokens) + 1}I", *posting_offsets))
+        out.write(token_blob)
+        out.write(posting_blob)
+        size = out.tell()
+    print(f"{path}: {len(tokens)} tokens, {sum(map(len, postings.values()))} postings in {size} bytes")
+
+
+def main() -> None:
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--db", default="src/tboggle/all.sqlite3")
+    ap.add_argument("--dawg", default="src/tboggle/words.dat")
+    ap.add_argument("-o", "--output", default="src/tboggle/defs.dat")
+    ap.add_argument("--index", default="src/tboggle/defs_index.dat")
+    args = ap.parse_args()
+
+    words = dawg_words(args.dawg)
+    with sqlite3.connect(args.db) as db:
+        found = dict(db.execute("SELECT word, def FROM defs"))
+    missing = sum(1 for w in words if w not in found)
+    if missing:
+        print(f"warning: {missing} dictionary words have no definition", file=sys.stderr)
+    defs = [(found.get(w) or "").encode("utf8") for w in words]
+    if any(b"\0" in d for d in defs):
+        sys.exit("definitions may not contain NUL")
+
+    zdict = train_dictionary(defs)
+    index, blocks, offset = [], [], 0
+    for start in range(0, len(defs), DEF_BLOCK_WORDS):
+        raw = b"\0".join(defs[start:start + DEF_BLOCK_WORDS]) + b"\0"
+        if len(raw) > DEF_BLOCK_MAX:
+            sys.exit(f"block at word {start} inflates to {len(raw)} bytes (max {DEF_BLOCK_MAX})")
+        packer = zlib.compressobj(9, zlib.DEFLATED, -15, 9, zdict=zdict)
+        packed = packer.compress(raw) + packer.flush()
+        index.append(offset)
+        blocks.append(packed)
+        offset += len(packed)
+    index.append(offset)
+
+    header = HEADER.pack(MAGIC, len(words), DEF_BLOCK_WORDS, len(blocks), len(zdict), offset, 0)
+    with open(args.output, "wb") as out:
+        out.write(header)
+        out.write(struct.pack(f"<{len(index)}I", *index))
+        out.write(zdict)
+        out.writelines(blocks)
+    total = HEADER.size + 4 * len(index) + len(zdict) + offset
+    raw_size = sum(len(d) + 1 for d in defs)
+    print(f"{args.output}: {len(words)} words, {len(blocks)} blocks, "
+          f"{raw_size} bytes of text in {total} bytes ({total / raw_size:.0%})")
+    write_index(args.index, [found.get(w) or "" for w in words])
+
+
+if __name__ == "__main__":
+    main()
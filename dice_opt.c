@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "dice_sets.h"
+#include "libwords.h"
+
+/**
+ * DICE-SET OPTIMIZER
+ *
+ * Simulated annealing over die faces: starting from an existing set, mutate
+ * one face (or swap two faces between dice) at a time and keep changes that
+ * move the set's board distribution towards a target.
+ *
+ *   ./dice_opt --set 4 --target words:p50=120 --target words:p10>=60
+ *   ./dice_opt --set 5 --letters ABCDEFGHIKLMNOPRSTUWY --digraphs 134 \
+ *              --target score:p50=250 --target longest:p90<=9 --iters 2000
+ *
+ * A target is METRIC:STAT OP VALUE with METRIC words, score or longest,
+ * STAT p1 p5 p10 p25 p50 p75 p90 p95 p99 or mean, and OP =, >= or <=. The
+ * cost of a candidate is the sum of squared relative misses; >= and <=
+ * targets only count when violated.
+ *
+ * Constraints: the die count never changes, and every face comes from
+ * --letters plus the digraph codes in --digraphs (libwords face codes:
+ * 1 QU, 2 IN, 3 TH, 4 ER, 5 HE, 6 AN). Starting faces outside them are
+ * replaced with random allowed faces before annealing.
+ *
+ * Each candidate is scored on --boards boards solved across all cores.
+ * Board i is always rolled from the same RNG stream (common random
+ * numbers): every candidate sees the same die order and face indices, so
+ * cost differences come from the faces, not from sampling noise. The final
+ * set is re-scored on a fresh sample to show how much of its cost was fit
+ * to that sample.
+ */
+
+#define MAX_TARGETS 16
+#define CHUNK 64
+
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+enum metric { M_WORDS, M_SCORE, M_LONGEST, NUM_METRICS };
+static const char *const metric_names[NUM_METRICS] = {"words", "score", "longest"};
+
+struct target {
+    enum metric metric;
+    double quantile;         // < 0 for mean
+    char op;                 // '=', '>' (>=) or '<' (<=)
+    double value;
+};
+
+static struct target g_targets[MAX_TARGETS];
+static int g_num_targets;
+
+// Evaluation: shared read-only candidate, results per board index
+static struct dice_set g_cand;
+static int g_boards = 2000;
+static uint64_t g_sample_seed;
+static int g_min_legal = 3;
+static int *g_results[NUM_METRICS];
+static atomic_int g_next;
+
+static bool parse_target(const char *spec) {
+    if (g_num_targets == MAX_TARGETS) return false;
+    struct target *t = &g_targets[g_num_targets];
+    char metric[16], stat[8], op[3];
+    double value;
+    if (sscanf(spec, "%15[a-z]:%7[a-z0-9]%2[=<>]%lf", metric, stat, op, &value) != 4) return false;
+
+    int m = 0;
+    while (m < NUM_METRICS && strcmp(metric, metric_names[m]) != 0) m++;
+    if (m == NUM_METRICS) return false;
+    t->metric = m;
+
+    if (strcmp(stat, "mean") == 0) t->quantile = -1;
+    else if (stat[0] == 'p' && atoi(stat + 1) > 0 && atoi(stat + 1) < 100) t->quantile = atoi(stat + 1) / 100.0;
+    else return false;
+
+    if (strcmp(op, "=") == 0) t->op = '=';
+    else if (strcmp(op, ">=") == 0) t->op = '>';
+    else if (strcmp(op, "<=") == 0) t->op = '<';
+    else return false;
+
+    t->value = value;
+    g_num_targets++;
+    return true;
+}
+
+static void *eval_worker(void *arg) {
+    (void)arg;
+    char dice[MAX_DICE + 1];
+    const int n = g_cand.num;
+    for (;;) {
+        const int start = atomic_fetch_add_explicit(&g_next, CHUNK, memory_order_relaxed);
+        if (start >= g_boards) break;
+        const int end = start + CHUNK < g_boards ? start + CHUNK : g_boards;
+        for (int i = start; i < end; i++) {
+            uint64_t rng = g_sample_seed << 32 ^ (uint64_t)i;
+            roll_board(&g_cand, &rng, dice);
+            struct board_totals r;
+            solve_board(g_scores, n, n, dice, g_min_legal, &r);
+            g_results[M_WORDS][i] = r.words;
+            g_results[M_SCORE][i] = r.score;
+            g_results[M_LONGEST][i] = r.longest;
+        }
+    }
+    return NULL;
+}
+
+static int cmp_int(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+/**
+ * Solve the sample for the candidate in g_cand and return its cost;
+ * achieved values per target go to got[].
+ */
+static double evaluate(int threads, double got[MAX_TARGETS]) {
+    pthread_t tids[threads];
+    atomic_store(&g_next, 0);
+    for (int t = 0; t < threads; t++) pthread_create(&tids[t], NULL, eval_worker, NULL);
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+
+    double mean[NUM_METRICS];
+    for (int m = 0; m < NUM_METRICS; m++) {
+        long long sum = 0;
+        for (int i = 0; i < g_boards; i++) sum += g_results[m][i];
+        mean[m] = (double)sum / g_boards;
+        qsort(g_results[m], g_boards, sizeof(int), cmp_int);
+    }
+
+    double cost = 0;
+    for (int k = 0; k < g_num_targets; k++) {
+        const struct target *t = &g_targets[k];
+        double v;
+        if (t->quantile < 0) {
+            v = mean[t->metric];
+        } else {
+            // Linear interpolation between order statistics
+            const double pos = t->quantile * (g_boards - 1);
+            const int lo = (int)pos;
+            const int hi = lo + 1 < g_boards ? lo + 1 : lo;
+            v = g_results[t->metric][lo] + (pos - lo) * (g_results[t->metric][hi] - g_results[t->metric][lo]);
+        }
+        got[k] = v;
+
+        const double miss = (v - t->value) / (fabs(t->value) > 1 ? fabs(t->value) : 1);
+        if (t->op == '=' || (t->op == '>' && miss < 0) || (t->op == '<' && miss > 0)) cost += miss * miss;
+    }
+    return cost;
+}
+
+static void print_targets(const double got[MAX_TARGETS]) {
+    for (int k = 0; k < g_num_targets; k++) {
+        const struct target *t = &g_targets[k];
+        printf("  %s:", metric_names[t->metric]);
+        if (t->quantile < 0) printf("mean");
+        else printf("p%d", (int)lround(t->quantile * 100));
+        printf(" %s %g -> %.1f\n", t->op == '=' ? "=" : t->op == '>' ? ">=" : "<=", t->value, got[k]);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *set_name = "4";
+    const char *letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    const char *digraphs = "";
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int iters = 500;
+    double temp0 = 0.05;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (i + 1 >= argc) goto usage;
+        if (strcmp(a, "--set") == 0) set_name = argv[++i];
+        else if (strcmp(a, "--target") == 0) {
+            if (!parse_target(argv[++i])) {
+                fprintf(stderr, "Bad target: %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (strcmp(a, "--letters") == 0) letters = argv[++i];
+        else if (strcmp(a, "--digraphs") == 0) digraphs = argv[++i];
+        else if (strcmp(a, "--boards") == 0) g_boards = atoi(argv[++i]);
+        else if (strcmp(a, "--iters") == 0) iters = atoi(argv[++i]);
+        else if (strcmp(a, "--temp") == 0) temp0 = atof(argv[++i]);
+        else if (strcmp(a, "--min-legal") == 0) g_min_legal = atoi(argv[++i]);
+        else if (strcmp(a, "--threads") == 0) threads = atol(argv[++i]);
+        else if (strcmp(a, "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else goto usage;
+    }
+    if (!g_num_targets || g_boards < 2 || iters < 0) goto usage;
+    if (threads < 1) threads = 1;
+
+    const struct dice_set *start = find_dice_set(set_name);
+    if (!start) {
+        fprintf(stderr, "Unknown dice set: %s\n", set_name);
+        return 2;
+    }
+
+    // Faces mutations may introduce
+    char alphabet[64];
+    int num_alpha = 0;
+    for (const char *c = letters; *c && num_alpha < 32; c++) {
+        if (*c >= 'A' && *c <= 'Z') alphabet[num_alpha++] = *c;
+    }
+    for (const char *c = digraphs; *c && num_alpha < 63; c++) {
+        if (*c >= '1' && *c <= '6') alphabet[num_alpha++] = *c;
+    }
+    if (num_alpha == 0) {
+        fprintf(stderr, "No allowed faces\n");
+        return 2;
+    }
+
+    // Start from the set with its disallowed faces replaced: mutations
+    // and swaps then only ever see allowed faces
+    uint64_t rng = seed * 0x9E3779B97F4A7C15ULL;
+    const int num_dice = start->num * start->num;
+    char cur[MAX_DICE][7], best[MAX_DICE][7], trial[MAX_DICE][7];
+    int replaced = 0;
+    for (int d = 0; d < num_dice; d++) {
+        memcpy(cur[d], start->dice[d], 7);
+        for (int f = 0; f < 6; f++) {
+            if (memchr(alphabet, cur[d][f], num_alpha)) continue;
+            cur[d][f] = alphabet[rng_next(&rng) % num_alpha];
+            replaced++;
+        }
+    }
+
+    read_dawg("src/tboggle/words.dat");
+    for (int m = 0; m < NUM_METRICS; m++) g_results[m] = malloc(g_boards * sizeof(int));
+    g_cand = (struct dice_set){"candidate", "candidate", start->num, {0}};
+    g_sample_seed = seed;
+
+    double got[MAX_TARGETS];
+    for (int d = 0; d < num_dice; d++) g_cand.dice[d] = cur[d];
+    double cur_cost = evaluate((int)threads, got);
+    double best_cost = cur_cost;
+    memcpy(best, cur, sizeof(cur));
+    printf("Start (%s, %d disallowed faces replaced): cost %.5f\n", start->name, replaced, cur_cost);
+    print_targets(got);
+
+    int accepted = 0;
+    for (int it = 0; it < iters; it++) {
+        // Geometric cooling from temp0 to temp0 / 1000
+        const double temp = temp0 * pow(1e-3, (double)it / (iters > 1 ? iters - 1 : 1));
+
+        // Mutate: usually replace one face, sometimes swap faces between dice
+        // (keeps the set's letter counts)
+        memcpy(trial, cur, sizeof(cur));
+        const int d1 = rng_next(&rng) % num_dice, f1 = rng_next(&rng) % 6;
+        if (rng_next(&rng) % 4 == 0) {
+            const int d2 = rng_next(&rng) % num_dice, f2 = rng_next(&rng) % 6;
+            const char tmp = trial[d1][f1];
+            trial[d1][f1] = trial[d2][f2];
+            trial[d2][f2] = tmp;
+        } else {
+            trial[d1][f1] = alphabet[rng_next(&rng) % num_alpha];
+        }
+        if (memcmp(trial, cur, sizeof(cur)) == 0) continue;
+
+        for (int d = 0; d < num_dice; d++) g_cand.dice[d] = trial[d];
+        const double cost = evaluate((int)threads, got);
+        const double u = (rng_next(&rng) >> 11) * 0x1.0p-53;
+        if (cost <= cur_cost || u < exp((cur_cost - cost) / temp)) {
+            memcpy(cur, trial, sizeof(cur));
+            cur_cost = cost;
+            accepted++;
+            if (cost < best_cost) {
+                best_cost = cost;
+                memcpy(best, trial, sizeof(trial));
+            }
+        }
+        if ((it + 1) % 50 == 0 || it + 1 == iters) {
+            fprintf(stderr, "iter %5d  temp %.5f  cost %.5f  best %.5f  accepted %d\n",
+                    it + 1, temp, cur_cost, best_cost, accepted);
+        }
+    }
+
+    for (int d = 0; d < num_dice; d++) g_cand.dice[d] = best[d];
+    printf("\nBest: cost %.5f on the optimization sample\n", evaluate((int)threads, got));
+    print_targets(got);
+    g_sample_seed = seed + 1;
+    printf("Fresh sample: cost %.5f\n", evaluate((int)threads, got));
+    print_targets(got);
+
+    for (int d = 0; d < num_dice; d++) {
+        for (int f = 0; f < 6; f++) {
+            if (!memchr(alphabet, best[d][f], num_alpha)) {
+                fprintf(stderr, "Internal error: die %d has disallowed face '%c'\n", d, best[d][f]);
+                return 1;
+            }
+        }
+    }
+
+    // Ready to paste into src/tboggle/dice.py (and mirror in dice_sets.c)
+    printf("\n    DiceSet(\n        \"%s-opt\",\n        \"%dx%d Optimized\",\n        %d,\n        [",
+           start->name, start->num, start->num, start->num);
+    for (int d = 0; d < num_dice; d++) {
+        char sorted[7];
+        memcpy(sorted, best[d], 7);
+        for (int a = 1; a < 6; a++) {
+            for (int b = a; b > 0 && sorted[b - 1] > sorted[b]; b--) {
+                const char tmp = sorted[b];
+                sorted[b] = sorted[b - 1];
+                sorted[b - 1] = tmp;
+            }
+        }
+        printf("%s\"%s\",", d % start->num ? " " : "\n            ", sorted);
+    }
+    printf("\n        ]),\n");
+    return 0;
+
+usage:
+    fprintf(stderr, "usage: %s [--set NAME] --target METRIC:STAT{=,>=,<=}VALUE ... [--letters A-Z] "
+            "[--digraphs CODES] [--boards N] [--iters N] [--temp T] [--min-legal N] "
+            "[--threads N] [--seed N]\n", argv[0]);
+    return 2;
+}
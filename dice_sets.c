@@ -0,0 +1,97 @@
+#include <string.h>
+
+#include "dice_sets.h"
+
+// Mirrors src/tboggle/dice.py (same names, dice and order).
+const struct dice_set dice_sets[] = {
+    {"4-classic", "4x4 Classic", 4, {
+        "AACIOT", "ABILTY", "ABJMOQ", "ACDEMP",
+        "ACELRS", "ADENVZ", "AHMORS", "BIFORX",
+        "DENOSW", "DKNOTU", "EEFHIY", "EGKLUY",
+        "EGINTV", "EHINPS", "ELPSTU", "GILRUW",
+    }},
+    {"4", "4x4 Revised", 4, {
+        "AAEEGN", "ABBJOO", "ACHOPS", "AFFKPS",
+        "AOOTTW", "CIMOTU", "DEILRX", "DELRVY",
+        "DISTTY", "EEGHNW", "EEINSU", "EHRTVW",
+        "EIOSST", "ELRTTY", "HIMNU1", "HLNNRZ",
+    }},
+    {"5-orig", "5x5 Original", 5, {
+        "AAAFRS", "AAEEEE", "AAFIRS", "ADENNN", "AEEEEM",
+        "AEEGMU", "AEGMNN", "AFIRSY", "BJK1XZ", "CCENST",
+        "CEIILT", "CEIPST", "DDHNOT", "DHHLOR", "DHHLOR",
+        "DHLNOR", "EIIITT", "CEILPT", "EMOTTT", "ENSSSU",
+        "FIPRSY", "GORRVW", "IPRRRY", "NOOTUW", "OOOTTU",
+    }},
+    {"5-challenge", "5x5 Challenge", 5, {
+        "AAAFRS", "AAEEEE", "AAFIRS", "ADENNN", "AEEEEM",
+        "AEEGMU", "AEGMNN", "AFIRSY", "BJK1XZ", "CCENST",
+        "CEIILT", "CEIPST", "DDHNOT", "DHHLOR", "IKLM1U",
+        "DHLNOR", "EIIITT", "CEILPT", "EMOTTT", "ENSSSU",
+        "FIPRSY", "GORRVW", "IPRRRY", "NOOTUW", "OOOTTU",
+    }},
+    {"5-big-deluxe", "5x5 Big Deluxe", 5, {
+        "AAAFRS", "AAEEEE", "AAFIRS", "ADENNN", "AEEEEM",
+        "AEEGMU", "AEGMNN", "AFIRSY", "BJK1XZ", "CCNSTW",
+        "CEIILT", "CEIPST", "DDLNOR", "DHHLOR", "DHHNOT",
+        "DHLNOR", "EIIITT", "CEILPT", "EMOTTT", "ENSSSU",
+        "FIPRSY", "GORRVW", "HIPRRY", "NOOTUW", "OOOTTU",
+    }},
+    {"5", "5x5 Big 2012", 5, {
+        "AAAFRS", "AAEEEE", "AAFIRS", "ADENNN", "AEEEEM",
+        "AEEGMU", "AEGMNN", "AFIRSY", "BBJKXZ", "CCENST",
+        "EIILST", "CEIPST", "DDHNOT", "DHHLOR", "DHHNOW",
+        "DHLNOR", "EIIITT", "EILPST", "EMOTTT", "ENSSSU",
+        "123456", "GORRVW", "IPRSYY", "NOOTUW", "OOOTTU",
+    }},
+    {"6-super", "6x6 Super Big", 6, {
+        "AAAFRS", "AAEEEE", "AAEEOO", "AAFIRS", "ABDEIO", "ADENNN",
+        "AEEEEM", "AEEGMU", "AEGMNN", "AEILMN", "AEINOU", "AFIRSY",
+        "123456", "BBJKXZ", "CCENST", "CDDLNN", "CEIITT", "CEIPST",
+        "CFGNUY", "DDHNOT", "DHHLOR", "DHHNOW", "DHLNOR", "EHILRS",
+        "EIILST", "EILPST", "EIO000", "EMTTTO", "ENSSSU", "GORRVW",
+        "HIRSTV", "HOPRST", "IPRSYY", "JK1WXZ", "NOOTUW", "OOOTTU",
+    }},
+    {"6", "6x6 Super Big Simple", 6, {
+        "AAAFRS", "AAEEEE", "AAEEOO", "AAFIRS", "ABDEIO", "ADENNN",
+        "AEEEEM", "AEEGMU", "AEGMNN", "AEILMN", "AEINOU", "AFIRSY",
+        "AEIOUS", "BBJKXZ", "CCENST", "CDDLNN", "CEIITT", "CEIPST",
+        "CFGNUY", "DDHNOT", "DHHLOR", "DHHNOW", "DHLNOR", "EHILRS",
+        "EIILST", "EILPST", "EIOSSS", "EMTTTO", "ENSSSU", "GORRVW",
+        "HIRSTV", "HOPRST", "IPRSYY", "JK1WXZ", "NOOTUW", "OOOTTU",
+    }},
+};
+
+const int num_dice_sets = sizeof(dice_sets) / sizeof(dice_sets[0]);
+
+const struct dice_set *find_dice_set(const char *name) {
+    for (int i = 0; i < num_dice_sets; i++) {
+        if (strcmp(dice_sets[i].name, name) == 0) return &dice_sets[i];
+    }
+    return NULL;
+}
+
+uint64_t rng_next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void roll_board(const struct dice_set *set, uint64_t *rng, char *out) {
+    const int len = set->num * set->num;
+    int order[MAX_DICE];
+    for (int i = 0; i < len; i++) order[i] = i;
+
+    // Fisher-Yates, same shape as shuffle_array() in libwords.c
+    for (int i = 0; i < len - 1; i++) {
+        const int j = i + (int)(rng_next(rng) % (uint64_t)(len - i));
+        const int tmp = order[j];
+        order[j] = order[i];
+        order[i] = tmp;
+    }
+    for (int i = 0; i < len; i++) {
+        out[i] = set->dice[order[i]][rng_next(rng) % 6];
+    }
+    out[len] = '\0';
+}
@@ -0,0 +1,43 @@
+#ifndef DICE_SETS_H
+#define DICE_SETS_H
+
+#include <stdint.h>
+
+/**
+ * DICE SETS FOR C TOOLS
+ *
+ * C mirror of the sets in src/tboggle/dice.py, so the golden corpus,
+ * benchmarks and analysis tools can roll boards without going through
+ * Python. Keep the two in sync: same names, same dice, same order.
+ *
+ * Face codes match libwords.c: '0' blank, '1' QU, '2' IN, '3' TH,
+ * '4' ER, '5' HE, '6' AN.
+ */
+
+#define MAX_DICE 36
+
+struct dice_set {
+    const char *name;
+    const char *desc;
+    int num;                          // Board is num x num
+    const char *dice[MAX_DICE];
+};
+
+extern const struct dice_set dice_sets[];
+extern const int num_dice_sets;
+
+const struct dice_set *find_dice_set(const char *name);
+
+/**
+ * Small reentrant RNG (splitmix64) so tools get reproducible boards per
+ * seed without touching libc random() state that fill_board() relies on.
+ */
+uint64_t rng_next(uint64_t *state);
+
+/**
+ * Roll a board: shuffle dice into positions, then pick a face per die.
+ * Writes num*num characters plus a terminating NUL into out.
+ */
+void roll_board(const struct dice_set *set, uint64_t *rng, char *out);
+
+#endif
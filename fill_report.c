@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "dice_sets.h"
+#include "libwords.h"
+
+/**
+ * FILL_BOARD TELEMETRY REPORT
+ *
+ * Generates boards for one constraint profile with fill_board telemetry
+ * on, then prints where the attempts went: which stage rejected them,
+ * which constraint, and histograms of time (and nodes visited, in a
+ * make STATS=1 build) per outcome.
+ *
+ *   ./fill_report --set 4 --min-words 200 --min-longest 9
+ *   ./fill_report --set 5 --max-score 150 --boards 50
+ *
+ * Options mirror Game.fill_board(): --min-words/--max-words,
+ * --min-score/--max-score, --min-longest/--max-longest (-1 = no max),
+ * plus --min-legal, --boards (generations to run), --max-tries, --seed.
+ * With --weights FILE (a word_probs table for --set), --min-difficulty and
+ * --max-difficulty apply too. --estimate SAMPLES turns on the sampled
+ * early rejection (set_fill_estimator()) at --estimate-z standard errors.
+ */
+
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+static const char *const outcome_names[NUM_ATTEMPT_OUTCOMES] = {
+    "accepted", "heuristic", "prefilter", "estimate", "max-violation", "min-violation",
+};
+
+static const char *const constraint_names[NUM_CONSTRAINTS] = {
+    "-", "words", "score", "longest", "difficulty",
+};
+
+static void print_histogram(const char *title, const char *unit,
+                            long long hist[NUM_ATTEMPT_OUTCOMES][TELEMETRY_BUCKETS]) {
+    int lo = TELEMETRY_BUCKETS, hi = -1;
+    for (int o = 0; o < NUM_ATTEMPT_OUTCOMES; o++) {
+        for (int b = 0; b < TELEMETRY_BUCKETS; b++) {
+            if (hist[o][b]) {
+                if (b < lo) lo = b;
+                if (b > hi) hi = b;
+            }
+        }
+    }
+    if (hi < 0) return;
+
+    printf("\n%s (log2 buckets, %s)\n", title, unit);
+    printf("  %-14s", ">=");
+    for (int o = 0; o < NUM_ATTEMPT_OUTCOMES; o++) printf(" %14s", outcome_names[o]);
+    printf("\n");
+    for (int b = lo; b <= hi; b++) {
+        printf("  %-14lld", b ? 1LL << b : 0);
+        for (int o = 0; o < NUM_ATTEMPT_OUTCOMES; o++) printf(" %14lld", hist[o][b]);
+        printf("\n");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *set_name = "4";
+    int min_words = 1, max_words = -1;
+    int min_score = 1, max_score = -1;
+    int min_longest = 3, max_longest = -1;
+    int min_legal = 3, boards = 20, max_tries = 1000000, seed = 1;
+    int min_difficulty = 0, max_difficulty = -1;
+    const char *weights = NULL;
+    int est_samples = 0;
+    double est_z = 3;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (i + 1 >= argc) goto usage;
+        if (strcmp(a, "--set") == 0) set_name = argv[++i];
+        else if (strcmp(a, "--min-words") == 0) min_words = atoi(argv[++i]);
+        else if (strcmp(a, "--max-words") == 0) max_words = atoi(argv[++i]);
+        else if (strcmp(a, "--min-score") == 0) min_score = atoi(argv[++i]);
+        else if (strcmp(a, "--max-score") == 0) max_score = atoi(argv[++i]);
+        else if (strcmp(a, "--min-longest") == 0) min_longest = atoi(argv[++i]);
+        else if (strcmp(a, "--max-longest") == 0) max_longest = atoi(argv[++i]);
+        else if (strcmp(a, "--min-legal") == 0) min_legal = atoi(argv[++i]);
+        else if (strcmp(a, "--boards") == 0) boards = atoi(argv[++i]);
+        else if (strcmp(a, "--max-tries") == 0) max_tries = atoi(argv[++i]);
+        else if (strcmp(a, "--seed") == 0) seed = atoi(argv[++i]);
+        else if (strcmp(a, "--weights") == 0) weights = argv[++i];
+        else if (strcmp(a, "--min-difficulty") == 0) min_difficulty = atoi(argv[++i]);
+        else if (strcmp(a, "--max-difficulty") == 0) max_difficulty = atoi(argv[++i]);
+        else if (strcmp(a, "--estimate") == 0) est_samples = atoi(argv[++i]);
+        else if (strcmp(a, "--estimate-z") == 0) est_z = atof(argv[++i]);
+        else goto usage;
+    }
+
+    const struct dice_set *set = find_dice_set(set_name);
+    if (!set) {
+        fprintf(stderr, "Unknown dice set: %s\n", set_name);
+        return 2;
+    }
+
+    read_dawg("src/tboggle/words.dat");
+    if (weights && !load_word_weights(weights, set->name)) {
+        fprintf(stderr, "Cannot load word weights: %s\n", weights);
+        return 2;
+    }
+    set_difficulty_limits(min_difficulty, max_difficulty);
+    set_fill_estimator(est_samples, est_z);
+    reset_fill_telemetry();
+    enable_fill_telemetry(true);
+
+    int successes = 0;
+    for (int b = 0; b < boards; b++) {
+        char *dice[MAX_DICE];
+        for (int i = 0; i < set->num * set->num; i++) dice[i] = (char *)set->dice[i];
+        int num_tries;
+        char *dice_simple;
+        if (get_words(dice, g_scores, set->num, set->num, min_words, max_words,
+                      min_score, max_score, min_longest, max_longest, min_legal,
+                      max_tries, seed + b, &num_tries, &dice_simple)) {
+            successes++;
+        }
+    }
+
+    struct fill_telemetry t;
+    get_fill_telemetry(&t);
+
+    long long total_ns = 0;
+    for (int o = 0; o < NUM_ATTEMPT_OUTCOMES; o++) total_ns += t.time_ns[o];
+
+    printf("Set %s: words %d..%d, score %d..%d, longest %d..%d, min_legal %d\n",
+           set->name, min_words, max_words, min_score, max_score, min_longest, max_longest, min_legal);
+    printf("Boards: %d/%d generated, %lld attempts (%.1f per board), %.3fs\n\n",
+           successes, boards, t.attempts, successes ? (double)t.attempts / successes : 0.0, total_ns / 1e9);
+
+    printf("  %-14s %10s %7s %12s %7s", "outcome", "attempts", "share", "mean us", "time");
+    if (t.have_nodes) printf(" %12s", "mean nodes");
+    printf("   by constraint\n");
+    for (int o = 0; o < NUM_ATTEMPT_OUTCOMES; o++) {
+        const long long n = t.outcomes[o];
+        printf("  %-14s %10lld %6.1f%% %12.2f %6.1f%%", outcome_names[o], n,
+               t.attempts ? 100.0 * n / t.attempts : 0.0,
+               n ? t.time_ns[o] / 1e3 / n : 0.0,
+               total_ns ? 100.0 * t.time_ns[o] / total_ns : 0.0);
+        if (t.have_nodes) printf(" %12.0f", n ? (double)t.nodes[o] / n : 0.0);
+        printf("  ");
+        for (int c = 1; c < NUM_CONSTRAINTS; c++) {
+            if (t.by_constraint[o][c]) printf(" %s=%lld", constraint_names[c], t.by_constraint[o][c]);
+        }
+        printf("\n");
+    }
+
+    print_histogram("Attempt time", "ns", t.time_hist);
+    if (t.have_nodes) print_histogram("Nodes visited", "nodes", t.nodes_hist);
+    return 0;
+
+usage:
+    fprintf(stderr, "usage: %s [--set NAME] [--min-words N] [--max-words N] [--min-score N] "
+            "[--max-score N] [--min-longest N] [--max-longest N] [--min-legal N] "
+            "[--boards N] [--max-tries N] [--seed N] [--weights FILE] [--min-difficulty N] "
+            "[--max-difficulty N] [--estimate SAMPLES] [--estimate-z Z]\n", argv[0]);
+    return 2;
+}
@@ -8,6 +8,29 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <zlib.h>
+
+#include "libwords.h"
+
+/**
+ * REENTRANT BUILD (compile-time optional)
+ *
+ * All per-board state below is plain globals for speed (see BOARD STATE).
+ * Building with -DLIBWORDS_REENTRANT (make REENTRANT=1) marks that state
+ * THREAD_LOCAL instead, so each thread gets its own hash table, board and
+ * counters and can solve boards concurrently. The DAWG stays a single
+ * shared read-only array; call read_dawg() before starting threads.
+ * fill_board() still draws from random(), whose state is process-wide.
+ */
+#ifdef LIBWORDS_REENTRANT
+#define THREAD_LOCAL _Thread_local
+#else
+#define THREAD_LOCAL
+#endif
 
 /**
  * WORD STORAGE HASH TABLE
@@ -24,18 +47,18 @@
 
 #define HASH_SIZE 15877      // Prime number to minimize hash collisions
 #define MAX_WORDS 5000       // Maximum words we expect to find on any board
-#define MAX_WORD_LEN 16      // Longest possible word in Boggle
+                             // (MAX_WORD_LEN lives in libwords.h)
 
 // Hash table storage: 2D array for direct word storage (no malloc needed)
-char hash_table[HASH_SIZE][MAX_WORD_LEN + 1];
+THREAD_LOCAL char hash_table[HASH_SIZE][MAX_WORD_LEN + 1];
 
 // Array of pointers into hash table for iteration (populated by walk())
-char *word_list[MAX_WORDS + 1];
-int word_count = 0;
+THREAD_LOCAL char *word_list[MAX_WORDS + 1];
+THREAD_LOCAL int word_count = 0;
 
 // Optimization: track which indices are used for O(used) reset
-int used_indices[MAX_WORDS + 1];
-int used_count = 0;
+THREAD_LOCAL int used_indices[MAX_WORDS + 1];
+THREAD_LOCAL int used_count = 0;
 
 /**
  * Hash function: djb2 algorithm
@@ -149,6 +172,78 @@ perror(err_msg); \
 exit(1); \
 }
 
+/**
+ * SOLVER STATISTICS (compile-time optional)
+ *
+ * Build with -DLIBWORDS_STATS (make STATS=1) to count what find_words()
+ * does: nodes visited, DAWG steps, why neighbor candidates are rejected,
+ * inserts vs duplicates and where fail-fast exits happen. Without the flag
+ * STAT_INC()/STAT_ADD() expand to nothing, so the normal build carries no
+ * counters at all in the hot path.
+ */
+#ifdef LIBWORDS_STATS
+static THREAD_LOCAL struct solver_stats g_stats;
+#define STAT_INC(field) (g_stats.field++)
+#define STAT_ADD(field, n) (g_stats.field += (n))
+#else
+#define STAT_INC(field) ((void)0)
+#define STAT_ADD(field, n) ((void)0)
+#endif
+
+bool get_solver_stats(struct solver_stats *out) {
+#ifdef LIBWORDS_STATS
+    *out = g_stats;
+    return true;
+#else
+    memset(out, 0, sizeof(*out));
+    return false;
+#endif
+}
+
+void reset_solver_stats(void) {
+#ifdef LIBWORDS_STATS
+    memset(&g_stats, 0, sizeof(g_stats));
+#endif
+}
+
+/**
+ * STATIC TRACEPOINTS (USDT)
+ *
+ * When <sys/sdt.h> is available (systemtap-sdt-dev / systemtap-sdt-devel)
+ * each PROBE() compiles to a single nop plus an ELF note describing where
+ * its arguments live, so production builds can be traced with bpftrace or
+ * perf without rebuilding and pay nothing when no tracer is attached.
+ * Without the header, or with -DLIBWORDS_NO_USDT, they expand to nothing.
+ * Example scripts are in tracing/.
+ *
+ * Probes (provider "libwords"):
+ *   read_dawg_start(path)             read_dawg_end(path, bytes)
+ *   fill_start(max_tries, w, h)       fill_end(tries or -1, board_id)
+ *   attempt(board_id, try)            heuristic_reject(board_id)
+ *   solve_start(board_id)             solve_end(board_id, completed, words, score, longest)
+ *
+ * solve_end's completed is 0 if a maximum stopped the search (fail-fast);
+ * the minimums are checked after it fires.
+ */
+#if !defined(LIBWORDS_NO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define LIBWORDS_USDT 1
+#endif
+#endif
+
+#ifdef LIBWORDS_USDT
+#define PROBE1(name, a) DTRACE_PROBE1(libwords, name, a)
+#define PROBE2(name, a, b) DTRACE_PROBE2(libwords, name, a, b)
+#define PROBE3(name, a, b, c) DTRACE_PROBE3(libwords, name, a, b, c)
+#define PROBE5(name, a, b, c, d, e) DTRACE_PROBE5(libwords, name, a, b, c, d, e)
+#else
+#define PROBE1(name, a) ((void)0)
+#define PROBE2(name, a, b) ((void)0)
+#define PROBE3(name, a, b, c) ((void)0)
+#define PROBE5(name, a, b, c, d, e) ((void)0)
+#endif
+
 /**
  * Dice array type definition
  * 
@@ -164,6 +259,19 @@ typedef char Dice[37];
  * Points to packed 32-bit integer array representing the word graph.
  */
 const int32_t *dawg;
+size_t dawg_nodes;           // Number of node slots, including unused index 0
+static int32_t *g_dawg_alloc;  // Allocation holding dawg (freed on replacement)
+
+static void dictionary_changed(void);
+
+// Make nodes (node 1 at nodes[1]) the dictionary, taking ownership of alloc
+static void set_dictionary(int32_t *alloc, const int32_t *nodes, size_t num_nodes) {
+    free(g_dawg_alloc);
+    g_dawg_alloc = alloc;
+    dawg = nodes;
+    dawg_nodes = num_nodes;
+    dictionary_changed();
+}
 
 /**
  * Load DAWG dictionary from binary file
@@ -178,6 +286,7 @@ const int32_t *dawg;
  * @param path Path to the binary DAWG file (typically "words.dat")
  */
 void read_dawg(const char *path) {
+    PROBE1(read_dawg_start, path);
     FILE *f = fopen(path, "rb");
     if (!f) FATAL2("Cannot open", path);
     
@@ -196,8 +305,610 @@ void read_dawg(const char *path) {
     if (fread(f2, size, 1, f) != 1) FATAL2("Cannot read dict at", path);
     
     // Skip first element (count) - DAWG indices start at 1
-    dawg = f2 + 1;
+    set_dictionary(f2, f2 + 1, size / sizeof(int32_t) - 1);
     fclose(f);
+    PROBE2(read_dawg_end, path, size);
+}
+
+/**
+ * WORD IDS
+ *
+ * Every dictionary word gets a dense ID, 0 .. num_dawg_words() - 1: its
+ * rank in DAWG order (alphabetical for words.dat). The rank falls out of a
+ * normal descent given g_word_counts, the number of words at or below each
+ * node: every sibling skipped on the way adds its count, and every word
+ * ending on the path (a proper prefix) adds one.
+ *
+ * The table is built on first use, along with the start-letter densities
+ * of the EXPLORATION ORDER. Multi-threaded callers should make one call (e.g.
+ * num_dawg_words()) after read_dawg() and before starting threads.
+ */
+static uint32_t *g_word_counts;
+static int g_num_dawg_words;
+static int g_start_density[26];     // Words per 1024 trie nodes below each first letter
+
+static uint32_t count_words(unsigned int i) { // NOLINT(*-no-recursion)
+    if (g_word_counts[i]) return g_word_counts[i];
+    uint32_t n = (dawg[i] & EOW_BIT_MASK) ? 1 : 0;
+    for (unsigned int c = dawg[i] >> CHILD_BIT_SHIFT; c; c = (dawg[c] & EOL_BIT_MASK) ? 0 : c + 1) {
+        n += count_words(c);
+    }
+    g_word_counts[i] = n;    // Every node is on some word's path, so n > 0
+    return n;
+}
+
+// Nodes of the (unshared) trie at or below DAWG node i, memoized per node
+static uint32_t count_trie_nodes(unsigned int i, uint32_t *memo) { // NOLINT(*-no-recursion)
+    if (memo[i]) return memo[i];
+    uint32_t n = 1;
+    for (unsigned int c = DAWG_CHILD(dawg, i); c; c = DAWG_NEXT(dawg, c)) n += count_trie_nodes(c, memo);
+    return memo[i] = n;
+}
+
+static void build_word_counts(void) {
+    g_word_counts = calloc(dawg_nodes, sizeof(uint32_t));
+    if (!g_word_counts) FATAL2("Cannot allocate", "word counts");
+    g_num_dawg_words = 0;
+    for (unsigned int i = 1; i; i = (dawg[i] & EOL_BIT_MASK) ? 0 : i + 1) {
+        g_num_dawg_words += count_words(i);
+    }
+
+    // Word density by first letter, for the search order (see EXPLORATION ORDER)
+    uint32_t *trie_nodes = calloc(dawg_nodes, sizeof(uint32_t));
+    if (!trie_nodes) FATAL2("Cannot allocate", "trie node counts");
+    for (unsigned int i = 1; i; i = DAWG_NEXT(dawg, i)) {
+        g_start_density[DAWG_LETTER(dawg, i) - 'A'] =
+            (int)((long long)g_word_counts[i] * 1024 / count_trie_nodes(i, trie_nodes));
+    }
+    free(trie_nodes);
+}
+
+int num_dawg_words(void) {
+    if (!g_word_counts) build_word_counts();
+    return g_num_dawg_words;
+}
+
+/**
+ * @param word Uppercase word (digraph tiles already expanded)
+ * @return The word's ID, or -1 if it isn't in the dictionary
+ */
+int word_to_id(const char *word) {
+    if (!g_word_counts) build_word_counts();
+    unsigned int i = 1;
+    int rank = 0;
+    for (const char *c = word; *c; c++) {
+        while (i != 0 && (dawg[i] & LTR_BIT_MASK) != *c) {
+            rank += g_word_counts[i];
+            i = (dawg[i] & EOL_BIT_MASK) ? 0 : i + 1;
+        }
+        if (i == 0) return -1;
+        if (c[1] == '\0') return (dawg[i] & EOW_BIT_MASK) ? rank : -1;
+        if (dawg[i] & EOW_BIT_MASK) rank++;
+        i = dawg[i] >> CHILD_BIT_SHIFT;
+    }
+    return -1;
+}
+
+/**
+ * @param id Word ID from word_to_id()
+ * @param[out] out Buffer of at least MAX_WORD_LEN + 1 bytes
+ * @return false if id is out of range
+ */
+bool id_to_word(int id, char *out) {
+    if (id < 0 || id >= num_dawg_words()) return false;
+    unsigned int i = 1;
+    int len = 0;
+    while (i != 0) {
+        if ((uint32_t)id >= g_word_counts[i]) {
+            id -= g_word_counts[i];
+            i = (dawg[i] & EOL_BIT_MASK) ? 0 : i + 1;
+            continue;
+        }
+        out[len++] = dawg[i] & LTR_BIT_MASK;
+        if (dawg[i] & EOW_BIT_MASK) {
+            if (id == 0) break;
+            id--;
+        }
+        i = dawg[i] >> CHILD_BIT_SHIFT;
+    }
+    out[len] = '\0';
+    return true;
+}
+
+/**
+ * PATTERN QUERIES
+ *
+ * find_matches() lists dictionary words in one pruned DAWG walk:
+ *   pattern   letters, '?' (any one letter) and '*' (any run, possibly
+ *             empty); NULL or "" matches everything, "PRE*" is a prefix.
+ *   letters   optional multiset the word must be spelled from, '?' being a
+ *             blank: sub-anagrams, or exact anagrams with
+ *             min_len = strlen(letters).
+ *   min_len, max_len   length filter (max_len < 0: no limit).
+ *
+ * The pattern runs as a bit-parallel NFA: bit k of the state means "the
+ * first k pattern characters are matched". A branch is abandoned as soon as
+ * the state is empty, the letters can't supply the next letter, or the word
+ * is max_len long, so a prefix or a short anagram touches only a few
+ * hundred nodes. Matches are word IDs, in alphabetical order, ranked with
+ * the WORD IDS counts as the walk goes. All state is on the stack.
+ */
+#define MAX_PATTERN_LEN 63
+
+struct match_query {
+    uint64_t step[26];    // Bit k: pattern[k] consumes this letter and advances
+    uint64_t star;        // Bit k: pattern[k] is '*' (consumes and stays)
+    uint64_t accept;      // Bit for "whole pattern matched"
+    int have[26];         // Letters still available (letters queries)
+    int blanks;
+    bool use_letters;
+    int min_len, max_len;
+    int limit, found;
+    int *ids;
+};
+
+// Let every '*' match the empty string
+static inline uint64_t star_closure(uint64_t state, uint64_t star) {
+    uint64_t grown;
+    while ((grown = state | (state & star) << 1) != state) state = grown;
+    return state;
+}
+
+static void match_walk(struct match_query *q, unsigned int i, int len, uint64_t state, int rank) { // NOLINT(*-no-recursion)
+    for (; i && q->found < q->limit; rank += g_word_counts[i], i = DAWG_NEXT(dawg, i)) {
+        const int c = DAWG_LETTER(dawg, i) - 'A';
+        const uint64_t next = star_closure((state & q->step[c]) << 1 | (state & q->star), q->star);
+        if (!next) continue;
+
+        bool blank = false;
+        if (q->use_letters) {
+            if (q->have[c]) q->have[c]--;
+            else if (q->blanks) q->blanks--, blank = true;
+            else continue;
+        }
+        if (DAWG_EOW(dawg, i) && len + 1 >= q->min_len && (next & q->accept)) {
+            q->ids[q->found++] = rank;
+        }
+        if (len + 1 < q->max_len) {
+            match_walk(q, DAWG_CHILD(dawg, i), len + 1, next, rank + (DAWG_EOW(dawg, i) ? 1 : 0));
+        }
+        if (q->use_letters) {
+            if (blank) q->blanks++;
+            else q->have[c]++;
+        }
+    }
+}
+
+/**
+ * @param pattern Wildcard pattern, or NULL for any word
+ * @param letters Letters to spell the word from ('?' = blank), or NULL
+ * @param min_len Shortest word to return
+ * @param max_len Longest word to return (-1: no limit)
+ * @param limit Size of ids
+ * @param[out] ids Matching word IDs (see id_to_word()), alphabetical
+ * @return Number of IDs written, or -1 for an invalid pattern or letters
+ */
+int find_matches(const char *pattern, const char *letters, int min_len, int max_len, int limit, int *ids) {
+    struct match_query q = {.min_len = min_len, .limit = limit, .ids = ids};
+    if (!pattern || !*pattern) pattern = "*";
+    const int n = (int)strlen(pattern);
+    if (n > MAX_PATTERN_LEN) return -1;
+
+    bool has_star = false;
+    for (int k = 0; k < n; k++) {
+        const int ch = toupper((unsigned char)pattern[k]);
+        if (ch == '*') {
+            q.star |= 1ull << k;
+            has_star = true;
+        } else if (ch == '?') {
+            for (int c = 0; c < 26; c++) q.step[c] |= 1ull << k;
+        } else if (ch >= 'A' && ch <= 'Z') {
+            q.step[ch - 'A'] |= 1ull << k;
+        } else {
+            return -1;
+        }
+    }
+    q.accept = 1ull << n;
+
+    if (letters) {
+        q.use_letters = true;
+        for (const char *l = letters; *l; l++) {
+            const int ch = toupper((unsigned char)*l);
+            if (ch == '?') q.blanks++;
+            else if (ch >= 'A' && ch <= 'Z') q.have[ch - 'A']++;
+            else return -1;
+        }
+    }
+
+    // Words can't outgrow the dictionary, a star-free pattern or the letters
+    q.max_len = max_len < 0 || max_len > MAX_WORD_LEN ? MAX_WORD_LEN : max_len;
+    if (!has_star && n < q.max_len) q.max_len = n;
+    if (letters && (int)strlen(letters) < q.max_len) q.max_len = (int)strlen(letters);
+    if (limit <= 0 || q.min_len > q.max_len) return 0;
+
+    if (!g_word_counts) build_word_counts();
+    match_walk(&q, 1, 0, star_closure(1, q.star), 0);
+    return q.found;
+}
+
+/**
+ * WORD WEIGHTS (difficulty)
+ *
+ * load_word_weights() memory-maps a word_probs.c table: per word ID, the
+ * surprisal of finding that word on a random board. While a table is
+ * loaded, find_words() carries the rank of its DAWG node down the search
+ * (as match_walk() does), so each newly inserted word's ID is at hand, and
+ * adds the word's weight to g_difficulty, the board's difficulty index
+ * (total rarity of its words, reported in bits). Without a table no ranks
+ * are kept and the solve costs what it always did.
+ *
+ * Words the sample never produced get a weight one bit rarer than a word
+ * seen once. Rarity depends on the dice, so a table only loads for the set
+ * named in its header; the caller must not fill boards from other sets.
+ */
+static const uint16_t *g_word_weights;
+static uint32_t g_never_weight;
+static THREAD_LOCAL const uint32_t *g_rank_counts;   // g_word_counts while weights are loaded, else NULL
+
+/**
+ * @param path word_probs.c output file
+ * @param set dice set name the table must have been sampled for
+ * @return false if the file can't be mapped or doesn't match this
+ *         dictionary and dice set
+ */
+bool load_word_weights(const char *path, const char *set) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    const off_t size = lseek(fd, 0, SEEK_END);
+    const int num_words = num_dawg_words();
+    if (size != (off_t)(sizeof(struct word_prob_header) + num_words * sizeof(uint16_t))) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const struct word_prob_header *h = map;
+    if (memcmp(h->magic, WORD_PROB_MAGIC, sizeof(h->magic)) != 0 || h->num_words != (uint32_t)num_words ||
+        strncmp(h->set, set, sizeof(h->set)) != 0) {
+        munmap(map, size);
+        return false;
+    }
+    int bits = 1;
+    while (bits < 63 && (1ULL << bits) <= h->boards) bits++;
+    g_never_weight = (bits + 1) * WORD_PROB_SCALE;
+    g_word_weights = (const uint16_t *)(h + 1);
+    return true;
+}
+
+/**
+ * DEFINITION STORE
+ *
+ * load_definitions() memory-maps a build_defs.py store: definitions by
+ * word ID, in small blocks that are raw-deflated with a shared preset
+ * dictionary (2MB for 4.7MB of text; all.sqlite3 is 12MB). get_definition()
+ * finds the block from the offset array, inflates it and skips to the
+ * word, a few microseconds with no locks and no SQLite. The mapping is
+ * read-only and shared between processes through the page cache.
+ *
+ * Callers include Python threads (ctypes drops the GIL), so the inflate
+ * stream and the last inflated block are _Thread_local in every build,
+ * not THREAD_LOCAL. A repeat lookup in the same block skips the inflate.
+ */
+static const struct def_store_header *g_defs;
+static const uint32_t *g_def_offsets;
+static const unsigned char *g_def_dict, *g_def_blob;
+
+static _Thread_local z_stream g_def_stream;
+static _Thread_local bool g_def_stream_ready;
+static _Thread_local const struct def_store_header *g_def_cached_store;
+static _Thread_local uint32_t g_def_cached_block;
+static _Thread_local char g_def_text[DEF_BLOCK_MAX];
+
+/**
+ * @param path build_defs.py output file
+ * @return false if the file can't be mapped or doesn't match this dictionary
+ */
+bool load_definitions(const char *path) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    const off_t size = lseek(fd, 0, SEEK_END);
+    if (size < (off_t)sizeof(struct def_store_header)) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const struct def_store_header *h = map;
+    const uint32_t *offsets = (const uint32_t *)(h + 1);
+    const off_t expected = sizeof(*h) + (off_t)(h->num_blocks + 1) * sizeof(uint32_t) + h->dict_size + h->blob_size;
+    if (memcmp(h->magic, DEF_STORE_MAGIC, sizeof(h->magic)) != 0 || h->num_words != (uint32_t)num_dawg_words() ||
+        h->block_words == 0 || h->num_blocks != (h->num_words + h->block_words - 1) / h->block_words ||
+        size != expected || offsets[h->num_blocks] != h->blob_size) {
+        munmap(map, size);
+        return false;
+    }
+    g_def_offsets = offsets;
+    g_def_dict = (const unsigned char *)(offsets + h->num_blocks + 1);
+    g_def_blob = g_def_dict + h->dict_size;
+    g_defs = h;    // Last: a store replaced while in use stays mapped
+    return true;
+}
+
+// Inflated text of a block (NUL-terminated definitions), or NULL if corrupt
+static const char *def_block(uint32_t block) {
+    if (g_def_cached_store == g_defs && g_def_cached_block == block) return g_def_text;
+    z_stream *s = &g_def_stream;
+    if (!g_def_stream_ready) {
+        if (inflateInit2(s, -MAX_WBITS) != Z_OK) return NULL;
+        g_def_stream_ready = true;
+    } else if (inflateReset(s) != Z_OK) {
+        return NULL;
+    }
+    g_def_cached_store = NULL;
+    if (inflateSetDictionary(s, g_def_dict, g_defs->dict_size) != Z_OK) return NULL;
+    s->next_in = (Bytef *)(g_def_blob + g_def_offsets[block]);
+    s->avail_in = g_def_offsets[block + 1] - g_def_offsets[block];
+    s->next_out = (Bytef *)g_def_text;
+    s->avail_out = sizeof(g_def_text);
+    if (inflate(s, Z_FINISH) != Z_STREAM_END) return NULL;
+    g_def_cached_store = g_defs;
+    g_def_cached_block = block;
+    return g_def_text;
+}
+
+// Definition of a valid ID inside its inflated block, or NULL if corrupt
+static const char *def_text(uint32_t id) {
+    const char *text = def_block(id / g_defs->block_words);
+    if (!text) return NULL;
+    for (uint32_t skip = id % g_defs->block_words; skip; skip--) text += strlen(text) + 1;
+    return text;
+}
+
+/**
+ * @param id Word ID (see word_to_id())
+ * @param[out] out Buffer for the definition, truncated to size - 1 bytes
+ * @param size Size of out
+ * @return Full length of the definition (0 if it has none), or -1 if no
+ *         store is loaded, id is out of range or the store is corrupt
+ */
+int get_definition(int id, char *out, int size) {
+    if (!g_defs || id < 0 || (uint32_t)id >= g_defs->num_words) return -1;
+    const char *text = def_text((uint32_t)id);
+    if (!text) return -1;
+    const int len = (int)strlen(text);
+    if (size > 0) {
+        const int n = len < size - 1 ? len : size - 1;
+        memcpy(out, text, n);
+        out[n] = '\0';
+    }
+    return len;
+}
+
+// Sort key for get_definitions(): ID in the high half, list position in the low
+static int cmp_u64(const void *a, const void *b) {
+    const uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Bulk lookup for a whole word list, e.g. a board's legal words at the end
+ * of a game. The IDs are visited in sorted order, so each block is
+ * inflated once whatever the order of the list. Definitions are written
+ * to out back to back, NUL-terminated, in visiting order.
+ *
+ * @param ids Word IDs (any order, duplicates allowed)
+ * @param n Number of IDs
+ * @param[out] out Definitions buffer
+ * @param size Size of out
+ * @param[out] offsets Per ids[k], offset of its definition in out, or -1
+ *             if it has none (invalid ID or empty definition)
+ * @return Bytes needed for out (if more than size, call again with a
+ *         bigger buffer), or -1 if no store is loaded or it is corrupt
+ */
+int get_definitions(const int *ids, int n, char *out, int size, int *offsets) {
+    if (!g_defs) return -1;
+    if (n <= 0) return 0;
+    uint64_t *order = malloc(n * sizeof(uint64_t));
+    if (!order) return -1;
+    for (int k = 0; k < n; k++) order[k] = (uint64_t)(uint32_t)ids[k] << 32 | (uint32_t)k;
+    qsort(order, n, sizeof(uint64_t), cmp_u64);
+
+    int used = 0;
+    for (int k = 0; k < n; k++) {
+        const uint32_t id = order[k] >> 32, pos = (uint32_t)order[k];
+        offsets[pos] = -1;
+        if (id >= g_defs->num_words) continue;
+        const char *text = def_text(id);
+        if (!text) {
+            used = -1;
+            break;
+        }
+        const int len = (int)strlen(text);
+        if (len == 0) continue;
+        if (used + len + 1 <= size) {
+            memcpy(out + used, text, len + 1);
+            offsets[pos] = used;
+        }
+        used += len + 1;
+    }
+    free(order);
+    return used;
+}
+
+/**
+ * DEFINITION INDEX (reverse lookup)
+ *
+ * load_definition_index() memory-maps the build_defs.py inverted index:
+ * every token of the definitions' text, sorted, with the IDs of the words
+ * whose definition contains it. search_definitions() answers "words whose
+ * definition mentions X" in well under a millisecond.
+ *
+ * Each query term is a token prefix: its tokens are a contiguous range
+ * found by binary search, and their posting lists are merged. A word must
+ * match every term. Its rank adds, per term, DEF_EXACT_WEIGHT for a whole
+ * token (else DEF_PREFIX_WEIGHT) minus the token's position in the
+ * definition: a definition that starts with "ice" ranks above one that
+ * mentions "iceberg" near its end. Ties go to the lower ID. Scratch arrays
+ * are per call, so searches are safe from any thread.
+ */
+#define DEF_MAX_TERMS 8
+#define DEF_EXACT_WEIGHT 512
+#define DEF_PREFIX_WEIGHT 256
+
+// build_defs.py STOP_WORDS: not indexed, so skipped as whole query terms
+static const char *const g_def_stop_words[] = {
+    "an", "and", "as", "at", "be", "by", "for", "in", "into", "is", "it", "of", "on", "or",
+    "that", "the", "to", "with",
+};
+
+static const struct def_index_header *g_def_index;
+static const uint32_t *g_def_token_offsets, *g_def_posting_offsets;
+static const char *g_def_tokens;
+static const unsigned char *g_def_postings;
+
+/**
+ * @param path build_defs.py --index output file
+ * @return false if the file can't be mapped or doesn't match this dictionary
+ */
+bool load_definition_index(const char *path) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    const off_t size = lseek(fd, 0, SEEK_END);
+    if (size < (off_t)sizeof(struct def_index_header)) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const struct def_index_header *h = map;
+    const off_t expected = sizeof(*h) + 2 * (off_t)(h->num_tokens + 1) * sizeof(uint32_t) + h->tokens_size + h->postings_size;
+    const uint32_t *token_offsets = (const uint32_t *)(h + 1);
+    const uint32_t *posting_offsets = token_offsets + h->num_tokens + 1;
+    if (memcmp(h->magic, DEF_INDEX_MAGIC, sizeof(h->magic)) != 0 || h->num_words != (uint32_t)num_dawg_words() ||
+        size != expected || token_offsets[h->num_tokens] > h->tokens_size ||
+        posting_offsets[h->num_tokens] != h->postings_size) {
+        munmap(map, size);
+        return false;
+    }
+    g_def_token_offsets = token_offsets;
+    g_def_posting_offsets = posting_offsets;
+    g_def_tokens = (const char *)(posting_offsets + h->num_tokens + 1);
+    g_def_postings = (const unsigned char *)g_def_tokens + h->tokens_size;
+    g_def_index = h;
+    return true;
+}
+
+// Compare token t with a prefix: 0 if t starts with it
+static int token_prefix_cmp(uint32_t t, const char *prefix, int len) {
+    const char *token = g_def_tokens + g_def_token_offsets[t];
+    const int token_len = (int)(g_def_token_offsets[t + 1] - g_def_token_offsets[t]);
+    const int c = memcmp(token, prefix, token_len < len ? token_len : len);
+    if (c) return c;
+    return token_len < len ? -1 : 0;
+}
+
+/**
+ * @param query Words to look for; each is matched as a token prefix
+ * @param limit Size of ids
+ * @param[out] ids Best-ranked word IDs first
+ * @return Number of IDs written, or -1 if no index is loaded
+ */
+int search_definitions(const char *query, int limit, int *ids) {
+    if (!g_def_index) return -1;
+
+    // Same tokenizing as build_defs.py: lowercase letter runs
+    char terms[DEF_MAX_TERMS][MAX_WORD_LEN * 2 + 1];
+    int term_lens[DEF_MAX_TERMS], num_terms = 0;
+    for (const char *q = query; *q && num_terms < DEF_MAX_TERMS;) {
+        if (!isalpha((unsigned char)*q)) {
+            q++;
+            continue;
+        }
+        int len = 0;
+        for (; isalpha((unsigned char)*q); q++) {
+            if (len < (int)sizeof(terms[0]) - 1) terms[num_terms][len++] = (char)tolower((unsigned char)*q);
+        }
+        terms[num_terms][len] = '\0';
+        // A finished stop word or single letter can't match (not indexed);
+        // as the last term it is still being typed, so keep it as a prefix
+        bool skip = *q && len == 1;
+        for (size_t s = 0; *q && !skip && s < sizeof(g_def_stop_words) / sizeof(g_def_stop_words[0]); s++) {
+            skip = strcmp(terms[num_terms], g_def_stop_words[s]) == 0;
+        }
+        if (!skip) term_lens[num_terms++] = len;
+    }
+    if (num_terms == 0 || limit <= 0) return 0;
+
+    const uint32_t num_words = g_def_index->num_words;
+    uint16_t *score = calloc(num_words, sizeof(uint16_t));
+    uint16_t *term_best = calloc(num_words, sizeof(uint16_t));
+    uint8_t *matched = calloc(num_words, sizeof(uint8_t));
+    int *touched = malloc(num_words * sizeof(int));
+    if (!score || !term_best || !matched || !touched) {
+        free(score), free(term_best), free(matched), free(touched);
+        return -1;
+    }
+
+    int num_touched = 0;
+    for (int t = 0; t < num_terms; t++) {
+        const uint8_t need = (uint8_t)((1u << t) - 1);    // Every earlier term
+        // First token >= the prefix
+        uint32_t lo = 0, hi = g_def_index->num_tokens;
+        while (lo < hi) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if (token_prefix_cmp(mid, terms[t], term_lens[t]) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        num_touched = 0;
+        for (uint32_t tok = lo; tok < g_def_index->num_tokens && token_prefix_cmp(tok, terms[t], term_lens[t]) == 0; tok++) {
+            const bool exact = g_def_token_offsets[tok + 1] - g_def_token_offsets[tok] == (uint32_t)term_lens[t];
+            const int weight = exact ? DEF_EXACT_WEIGHT : DEF_PREFIX_WEIGHT;
+            const unsigned char *p = g_def_postings + g_def_posting_offsets[tok];
+            const unsigned char *end = g_def_postings + g_def_posting_offsets[tok + 1];
+            uint32_t id = 0;
+            while (p < end) {
+                uint32_t delta = 0;
+                for (int shift = 0;; shift += 7) {
+                    delta |= (uint32_t)(*p & 0x7F) << shift;
+                    if (!(*p++ & 0x80)) break;
+                }
+                id += delta;
+                const int pos = *p++;
+                if (id >= num_words || matched[id] != need) continue;
+                const uint16_t s = (uint16_t)(weight - pos);
+                if (!term_best[id]) touched[num_touched++] = (int)id;
+                if (s > term_best[id]) term_best[id] = s;
+            }
+        }
+        for (int k = 0; k < num_touched; k++) {
+            const int id = touched[k];
+            score[id] += term_best[id];
+            matched[id] |= (uint8_t)(1u << t);
+            term_best[id] = 0;
+        }
+    }
+
+    // touched now holds exactly the words matching every term: rank them
+    uint64_t *ranked = malloc((size_t)num_touched * sizeof(uint64_t) + 1);
+    int found = -1;
+    if (ranked) {
+        for (int k = 0; k < num_touched; k++) {
+            const int id = touched[k];
+            ranked[k] = (uint64_t)(0xFFFFu - score[id]) << 32 | (uint32_t)id;
+        }
+        qsort(ranked, num_touched, sizeof(uint64_t), cmp_u64);
+        found = num_touched < limit ? num_touched : limit;
+        for (int k = 0; k < found; k++) ids[k] = (int)(uint32_t)ranked[k];
+        free(ranked);
+    }
+    free(score), free(term_best), free(matched), free(touched);
+    return found;
 }
 
 
@@ -208,33 +919,41 @@ void read_dawg(const char *path) {
  * of struct passing. This eliminates pointer dereferencing overhead and
  * improves cache locality for the performance-critical word-finding recursion.
  * 
- * Note: This makes the code non-reentrant but significantly faster.
+ * Note: This makes the code non-reentrant but significantly faster
+ * (unless built with LIBWORDS_REENTRANT, see top of file).
  */
 
 // Board dimensions and boundaries
-static int g_board_width, g_board_height;  // Current board size (typically 4x4)
-static int g_max_x, g_max_y;               // Cached boundary values (width-1, height-1)
+static THREAD_LOCAL int g_board_width, g_board_height;  // Current board size (typically 4x4)
+static THREAD_LOCAL int g_max_x, g_max_y;               // Cached boundary values (width-1, height-1)
 
 // Scoring and word building
-static const int *g_score_counts;          // Points per word length (from Python)
-static char g_word[MAX_WORD_LEN + 1];      // Buffer for current word being built
-static bool g_board_failed;                // Ultra-fast fail-fast flag for constraints
+static THREAD_LOCAL const int *g_score_counts;          // Points per word length (from Python)
+static THREAD_LOCAL char g_word[MAX_WORD_LEN + 1];      // Buffer for current word being built
+static THREAD_LOCAL bool g_board_failed;                // Ultra-fast fail-fast flag for constraints
+static THREAD_LOCAL enum constraint_id g_fail_reason;   // Which constraint failed (cold path only)
+static THREAD_LOCAL unsigned long long g_board_id;      // Serial number of the board being solved (for tracing)
 
 // Dice and board configuration  
-static char **g_dice_set;                  // Array of die face strings
-static Dice g_dice;                        // Current board: array of selected characters
+static THREAD_LOCAL char **g_dice_set;                  // Array of die face strings
+static THREAD_LOCAL Dice g_dice;                        // Current board: array of selected characters
 
 // Game constraints (set by caller)
-static int g_min_words, g_max_words;       // Word count constraints
-static int g_min_score, g_max_score;       // Score constraints
-static int g_min_longest, g_max_longest;   // Longest word constraints
-static int g_min_legal;                    // Minimum word length to count
+static THREAD_LOCAL int g_min_words, g_max_words;       // Word count constraints
+static THREAD_LOCAL int g_min_score, g_max_score;       // Score constraints
+static THREAD_LOCAL int g_min_longest, g_max_longest;   // Longest word constraints
+static THREAD_LOCAL int g_min_legal;                    // Minimum word length to count
+static THREAD_LOCAL long long g_min_difficulty;         // Difficulty constraints (weight units,
+static THREAD_LOCAL long long g_max_difficulty;         //   see WORD WEIGHTS)
+static THREAD_LOCAL int g_req_min_difficulty = 0;       // As set by set_difficulty_limits() (bits)
+static THREAD_LOCAL int g_req_max_difficulty = -1;
 
 // Current game state (updated during word finding)
-static char **g_word_array;                // Result: array of found words
-static int g_num_words;                    // Count of words found
-static int g_longest;                      // Length of longest word found
-static int g_score;                        // Total score of found words
+static THREAD_LOCAL char **g_word_array;                // Result: array of found words
+static THREAD_LOCAL int g_num_words;                    // Count of words found
+static THREAD_LOCAL int g_longest;                      // Length of longest word found
+static THREAD_LOCAL int g_score;                        // Total score of found words
+static THREAD_LOCAL long long g_difficulty;             // Total weight of found words
 
 /**
  * Neighbor direction lookup table
@@ -262,18 +981,87 @@ static const int g_deltas[8][2] = {
  * '3' -> "TH"
  * '4' -> "ER"
  * '5' -> "HE"
+ * '6' -> "AN"
  */
-static const char g_special_dice[6][2] = {
+static const char g_special_dice[7][2] = {
     {'_', '_'},  // '0': Placeholder for unused
     {'Q', 'U'},  // '1': QU combination
     {'I', 'N'},  // '2': IN combination
     {'T', 'H'},  // '3': TH combination
     {'E', 'R'},  // '4': ER combination
-    {'H', 'E'}   // '5': HE combination
+    {'H', 'E'},  // '5': HE combination
+    {'A', 'N'}   // '6': AN combination
 };
 
 
 
+/**
+ * EXPLORATION ORDER
+ *
+ * find_words() takes start tiles and neighbors from per-board tables:
+ * start tiles row-major, neighbors in g_deltas order. When a maximum is
+ * active (words, score, longest or difficulty), a board that breaks it is
+ * only rejected once the search has found enough words, so
+ * order_exploration() starts from the tiles expected to yield the most
+ * words per node visited: by the dictionary's word density below the
+ * tile's first letter (words per trie node; Y, Q and K lead, U and N
+ * trail). Ties keep row-major order, so the order is deterministic.
+ *
+ * Measured on capped fill_board profiles (4x4 to 6x6, max words or max
+ * score), this visits 12-19% fewer nodes. Ordering by letter frequency or
+ * vowel adjacency visited more nodes than row-major, and ordering
+ * neighbors too made no difference, so neighbors keep the fixed order.
+ *
+ * Order changes when a violation is found, never the outcome: the word
+ * set, and with it every total and the accept decision, is the same. Only
+ * the order of the word list would differ, so find_all_words() searches an
+ * accepted board once more in the default order (one extra solve per fill).
+ */
+static THREAD_LOCAL uint8_t g_nbrs[36][8];           // Neighbors of each tile, in search order
+static THREAD_LOCAL uint8_t g_num_nbrs[36];
+static THREAD_LOCAL uint8_t g_starts[36];            // Start tiles in search order
+static THREAD_LOCAL int g_nbrs_width, g_nbrs_height;  // Board size of g_nbrs (0: not built)
+
+// Row-major start tiles, and neighbor tables if the board size changed
+static void default_exploration(void) {
+    const int w = g_board_width, h = g_board_height;
+    for (int t = 0; t < w * h; t++) g_starts[t] = t;
+    if (g_nbrs_width == w && g_nbrs_height == h) return;
+    for (int t = 0; t < w * h; t++) {
+        const int y = t / w, x = t % w;
+        g_num_nbrs[t] = 0;
+        for (int d = 0; d < 8; d++) {
+            const int ny = y + g_deltas[d][0];
+            const int nx = x + g_deltas[d][1];
+            if (ny >= 0 && ny <= g_max_y && nx >= 0 && nx <= g_max_x) {
+                g_nbrs[t][g_num_nbrs[t]++] = ny * w + nx;
+            }
+        }
+    }
+    g_nbrs_width = w;
+    g_nbrs_height = h;
+}
+
+static void order_exploration(void) {
+    const int n = g_board_width * g_board_height;
+    int density[36];
+
+    if (!g_word_counts) build_word_counts();
+    default_exploration();
+    for (int t = 0; t < n; t++) {
+        const char face = g_dice[t];
+        const char first = face >= 'A' ? face : g_special_dice[face - '0'][0];
+        density[t] = first >= 'A' ? g_start_density[first - 'A'] : -1;   // Blank: never a word
+    }
+    // Stable insertion sort by descending density
+    for (int k = 1; k < n; k++) {
+        const uint8_t t = g_starts[k];
+        int j = k;
+        for (; j > 0 && density[g_starts[j - 1]] < density[t]; j--) g_starts[j] = g_starts[j - 1];
+        g_starts[j] = t;
+    }
+}
+
 /**
  * Fisher-Yates shuffle for random dice arrangement
  * 
@@ -318,6 +1106,66 @@ void make_dice() {
     for (int i = 0; i < len; i++) {
         g_dice[i] = g_dice_set[i][random() % NUM_FACES];
     }
+    g_board_id++;
+}
+
+/**
+ * Record the word in g_word[0 .. word_len) as found (once), checking the
+ * maximum constraints. Shared by every solving engine.
+ *
+ * @param id The word's ID (only used while word weights are loaded)
+ * @return false if the board now breaks a maximum (stop searching)
+ */
+static inline bool add_word(int word_len, int id) {
+    g_word[word_len] = '\0';
+    if (!insert(g_word)) {
+        STAT_INC(duplicates);
+        return true;
+    }
+
+    STAT_INC(words_inserted);
+    g_num_words++;
+    if (g_num_words > g_max_words) {
+        STAT_INC(fail_fast_exits);
+        STAT_INC(fail_fast_depth[word_len]);
+        g_fail_reason = CONSTRAINT_WORDS;
+        g_board_failed = true;
+        return false;
+    }
+
+    g_score += g_score_counts[word_len];
+    if (g_score > g_max_score) {
+        STAT_INC(fail_fast_exits);
+        STAT_INC(fail_fast_depth[word_len]);
+        g_fail_reason = CONSTRAINT_SCORE;
+        g_board_failed = true;
+        return false;
+    }
+
+    if (word_len > g_longest) {
+        g_longest = word_len;
+        if (g_longest > g_max_longest) {
+            STAT_INC(fail_fast_exits);
+            STAT_INC(fail_fast_depth[word_len]);
+            g_fail_reason = CONSTRAINT_LONGEST;
+            g_board_failed = true;
+            return false;
+        }
+    }
+
+    if (g_word_weights) {
+        const uint16_t weight = g_word_weights[id];
+        g_difficulty += weight == WORD_PROB_NEVER ? g_never_weight : weight;
+        if (g_difficulty > g_max_difficulty) {
+            STAT_INC(fail_fast_exits);
+            STAT_INC(fail_fast_depth[word_len]);
+            g_fail_reason = CONSTRAINT_DIFFICULTY;
+            g_board_failed = true;
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /**
@@ -341,9 +1189,10 @@ void make_dice() {
  * - Special dice lookup table for O(1) character expansion
  * 
  * @param i DAWG node index (current position in dictionary tree)
+ * @param rank ID of the first word at or below sibling list i (kept only
+ *             while word weights are loaded, see WORD WEIGHTS)
  * @param word_len Current length of word being built
- * @param y Row position of current tile (0-based)
- * @param x Column position of current tile (0-based)  
+ * @param t Index of the current tile (row-major)
  * @param used Bitmask of already-used tile positions
  * 
  * @return true if search should continue, false if constraints violated
@@ -352,38 +1201,42 @@ void make_dice() {
 
 static bool find_words( // NOLINT(*-no-recursion)
         unsigned int i,
+        int rank,
         int word_len,
-        const int y,
-        const int x,
+        const int t,
         int_least64_t used)
 {
     // Ultra-fast fail-fast check
     if (g_board_failed) return false;
+    STAT_INC(nodes_visited);
     
-    // Cache board dimensions in local variables for better register allocation
-    const int w = g_board_width;
-
-    // If not a legal tile, can't make word here
-    // if (y < 0 || y >= h || x < 0 || x >= w) return true;
-
-    // Make a bitmask for this tile position
-    const int_least64_t mask = 0x1 << (y * w + x);
+    // Make a bitmask for this tile position (64-bit: 6x6 boards use 36 bits)
+    const int_least64_t mask = (int_least64_t)1 << t;
 
     // If we've already used this tile, can't make word here
-    if (used & mask) return true;
+    if (used & mask) {
+        STAT_INC(rejected_used);
+        return true;
+    }
 
     // Find the DAWG-node for existing-DAWG-node plus this letter.
-    const char sought = g_dice[y * w + x];
+    const char sought = g_dice[t];
 
     if (sought >= 'A') {
         // Cache dawg array access
         const int32_t *dawg_ptr = dawg;
+        STAT_INC(dawg_lookups);
         while (i != 0 && (dawg_ptr[i] & LTR_BIT_MASK) != sought) {
+            STAT_INC(sibling_steps);
+            if (g_rank_counts) rank += g_rank_counts[i];
             i = (dawg_ptr[i] & EOL_BIT_MASK) ? 0 : i + 1;
         }
 
         // There are no words continuing with this letter
-        if (i == 0) return true;
+        if (i == 0) {
+            STAT_INC(rejected_no_child);
+            return true;
+        }
 
         // Either this is a word or the stem of a word. So update our 'word' to
         // include this letter.
@@ -396,18 +1249,31 @@ static bool find_words( // NOLINT(*-no-recursion)
 
         // Cache dawg array access
         const int32_t *dawg_ptr = dawg;
+        STAT_INC(dawg_lookups);
         while (i != 0 && (dawg_ptr[i] & LTR_BIT_MASK) != t1) {
+            STAT_INC(sibling_steps);
+            if (g_rank_counts) rank += g_rank_counts[i];
             i = (dawg_ptr[i] & EOL_BIT_MASK) ? 0 : i + 1;
         }
 
         // There are no words continuing with this letter
-        if (i == 0) return true;
+        if (i == 0) {
+            STAT_INC(rejected_no_child);
+            return true;
+        }
 
+        if (dawg_ptr[i] & EOW_BIT_MASK) rank++;   // The one-letter word t1 comes first
         i = dawg_ptr[i] >> CHILD_BIT_SHIFT;
+        STAT_INC(dawg_lookups);
         while (i != 0 && (dawg_ptr[i] & LTR_BIT_MASK) != t2) {
+            STAT_INC(sibling_steps);
+            if (g_rank_counts) rank += g_rank_counts[i];
             i = (dawg_ptr[i] & EOL_BIT_MASK) ? 0 : i + 1;
         }
-        if (i == 0) return true;
+        if (i == 0) {
+            STAT_INC(rejected_no_child);
+            return true;
+        }
 
         // Either this is a word or the stem of a word. So update our 'word' to
         // include this letter.
@@ -419,105 +1285,362 @@ static bool find_words( // NOLINT(*-no-recursion)
     used |= mask;
 
     // Add this word to the found-words.
-    if ((dawg[i] & EOW_BIT_MASK) && word_len >= g_min_legal) {
-        g_word[word_len] = '\0';
-
-        if (insert(g_word)) {
-            g_num_words++;
-            if (g_num_words > g_max_words) {
-                g_board_failed = true;
-                return false;
-            }
-
-            g_score += g_score_counts[word_len];
-            if (g_score > g_max_score) {
-                g_board_failed = true;
-                return false;
-            }
-
-            if (word_len > g_longest) {
-                g_longest = word_len;
-                if (g_longest > g_max_longest) {
-                    g_board_failed = true;
-                    return false;
-                }
-            }
-        }
-    }
+    if ((dawg[i] & EOW_BIT_MASK) && word_len >= g_min_legal && !add_word(word_len, rank)) return false;
 
-    // Check every direction H/V/D from here (will also re-check this tile, but
-    // the can't-reuse-this-tile rule prevents it from actually succeeding)
+    // Check every neighbor from here
 
     const unsigned int child = dawg[i] >> CHILD_BIT_SHIFT;
-    for (int d = 0; d < 8; d++) {
-        const int ny = y + g_deltas[d][0];
-        const int nx = x + g_deltas[d][1];
-        if (ny >= 0 && ny <= g_max_y && nx >= 0 && nx <= g_max_x) {
-            if (!find_words(child, word_len, ny, nx, used)) return false;
-        }
+    const int child_rank = rank + ((dawg[i] & EOW_BIT_MASK) ? 1 : 0);
+    const int num_nbrs = g_num_nbrs[t];
+    STAT_ADD(rejected_bounds, 8 - num_nbrs);
+    for (int k = 0; k < num_nbrs; k++) {
+        if (!find_words(child, child_rank, word_len, g_nbrs[t][k], used)) return false;
     }
 
     return true;
 }
 
 
-/**
- * Find all valid words on the current board
- * 
- * Entry point for word finding. Initiates recursive search from every
- * position on the board and validates final results against constraints.
- * 
- * PROCESS:
- * 1. Reset hash table and counters for new search
- * 2. Try starting a word from each board position
- * 3. find_words() recursively explores all possible paths
- * 4. Check final board statistics against min/max constraints
- * 
- * @return true if board meets all word/score/length requirements, false otherwise
- */
-bool find_all_words() {
-    // Initialize for new word search
+// Clear the word list, totals and fail-fast state before a search
+static void reset_search(void) {
     reset_hash_table();
     g_num_words = 0;
     g_longest = 0;
     g_score = 0;
+    g_difficulty = 0;
     g_board_failed = false;  // Reset fail-fast optimization flag
+    g_fail_reason = CONSTRAINT_NONE;
+}
 
-    // Try starting words from every position on the board
-    for (int y = 0; y < g_board_height; y++) {
-        for (int x = 0; x < g_board_width; x++) {
-            // Start with DAWG root (index 1), empty word, no tiles used
-            if (!find_words(1, 0, y, x, 0x0)) {
-                return false;  // Constraint violation during search
+// Search the board from every start tile, from a clean slate
+static bool search_board(void) {
+    reset_search();
+    g_rank_counts = g_word_weights ? g_word_counts : NULL;
+    for (int k = 0; k < g_board_width * g_board_height; k++) {
+        // Start with DAWG root (index 1), rank 0, empty word, no tiles used
+        if (!find_words(1, 0, 0, g_starts[k], 0x0)) return false;
+    }
+    return true;
+}
+
+/**
+ * REVERSE ENGINE
+ *
+ * find_words() walks the board and follows the dictionary; the reverse
+ * engine walks the dictionary and looks for each word on the board. It
+ * wins when the dictionary is small next to the number of board paths it
+ * opens (a few thousand words for young players, see load_word_list()):
+ * most words fail a test of their letter mask against the board's, most
+ * survivors a test of their letter counts, and only the rest are traced.
+ *
+ * The word store is built from the DAWG on first use, laid out for that
+ * scan: masks and lengths in arrays of their own, the text apart. It is
+ * shared by all threads (the first to finish building publishes it, the
+ * others free theirs) and dropped when the dictionary changes.
+ *
+ * Words are found in dictionary order, so find_all_words() lists the words
+ * of an accepted board with a find_words() search, keeping the order of
+ * every word list independent of the engine. The reverse engine pays off
+ * where most boards are rejected (fill_board()).
+ */
+struct word_store {
+    int num_words;
+    uint32_t *masks;         // Letters each word contains (bit 0 = A)
+    uint8_t *lengths;
+    uint32_t *offsets;       // Start of each word in text
+    char *text;              // NUL-terminated words, in DAWG order (index = word ID)
+};
+
+static struct word_store *_Atomic g_word_store;
+
+static void free_word_store(struct word_store *s) {
+    if (!s) return;
+    free(s->masks);
+    free(s->lengths);
+    free(s->offsets);
+    free(s->text);
+    free(s);
+}
+
+// Count the words below sibling list i, and store them once s->text is allocated
+static void store_walk(struct word_store *s, size_t *text_len, char *word, unsigned int i, int len) { // NOLINT(*-no-recursion)
+    for (; i; i = DAWG_NEXT(dawg, i)) {
+        word[len] = DAWG_LETTER(dawg, i);
+        if (DAWG_EOW(dawg, i)) {
+            if (s->text) {
+                uint32_t mask = 0;
+                for (int k = 0; k <= len; k++) mask |= 1u << (word[k] - 'A');
+                s->masks[s->num_words] = mask;
+                s->lengths[s->num_words] = len + 1;
+                s->offsets[s->num_words] = *text_len;
+                memcpy(s->text + *text_len, word, len + 1);
+                s->text[*text_len + len + 1] = '\0';
             }
+            s->num_words++;
+            *text_len += len + 2;
         }
+        store_walk(s, text_len, word, DAWG_CHILD(dawg, i), len + 1);
     }
-    
-    // Validate final results against all constraints
-    if (g_num_words < g_min_words) return false;
-    if (g_score < g_min_score) return false;
-    if (g_longest < g_min_longest) return false;
-    if (g_longest > g_max_longest) return false;
+}
 
-    return true;  // Board meets all requirements
+static const struct word_store *word_store(void) {
+    struct word_store *s = atomic_load_explicit(&g_word_store, memory_order_acquire);
+    if (s) return s;
+
+    char word[MAX_WORD_LEN + 1];
+    size_t text_len = 0;
+    s = calloc(1, sizeof(*s));
+    if (!s) FATAL2("Cannot allocate", "word store");
+    store_walk(s, &text_len, word, 1, 0);
+    const size_t n = s->num_words + 1;
+    s->masks = malloc(n * sizeof(uint32_t));
+    s->lengths = malloc(n);
+    s->offsets = malloc(n * sizeof(uint32_t));
+    s->text = malloc(text_len + 1);
+    if (!s->masks || !s->lengths || !s->offsets || !s->text) FATAL2("Cannot allocate", "word store");
+    s->num_words = 0;
+    text_len = 0;
+    store_walk(s, &text_len, word, 1, 0);
+
+    struct word_store *expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&g_word_store, &expected, s, memory_order_acq_rel,
+                                                 memory_order_acquire)) {
+        free_word_store(s);    // Another thread published first
+        return expected;
+    }
+    return s;
+}
+
+// Tiles by the (first) letter of their face, and each tile's neighbors, as tile masks
+static THREAD_LOCAL uint64_t g_rev_tiles[26];
+static THREAD_LOCAL uint64_t g_rev_nbrs[36];
+
+// Can rest be spelled from one of the tiles in cands, without the tiles in used?
+static bool rev_trace(const char *rest, uint64_t cands, uint64_t used) { // NOLINT(*-no-recursion)
+    cands &= g_rev_tiles[rest[0] - 'A'] & ~used;
+    while (cands) {
+        const int t = __builtin_ctzll(cands);
+        cands &= cands - 1;
+        const char face = g_dice[t];
+        const char *next = rest + 1;
+        if (face < 'A') {
+            if (*next != g_special_dice[face - '0'][1]) continue;
+            next++;
+        }
+        if (!*next || rev_trace(next, g_rev_nbrs[t], used | (uint64_t)1 << t)) return true;
+    }
+    return false;
+}
+
+// Every dictionary word on the board, via add_word(); false on fail-fast
+static bool reverse_search(void) {
+    const struct word_store *s = word_store();
+    const int num_tiles = g_board_width * g_board_height;
+
+    // What the board can supply: letter counts (a digraph tile supplies
+    // both of its own), and which letter can follow which
+    uint8_t supply[26] = {0};
+    uint32_t follows[26] = {0};
+    uint32_t board_mask = 0;
+    int board_letters = 0;
+    memset(g_rev_tiles, 0, sizeof(g_rev_tiles));
+    for (int t = 0; t < num_tiles; t++) {
+        const char face = g_dice[t];
+        g_rev_nbrs[t] = 0;
+        if (face == '0') continue;    // Blank
+        const char *letters = face >= 'A' ? &g_dice[t] : g_special_dice[face - '0'];
+        const int n = face >= 'A' ? 1 : 2;
+        const int last = letters[n - 1] - 'A';
+        for (int k = 0; k < n; k++) supply[letters[k] - 'A']++;
+        if (n == 2) follows[letters[0] - 'A'] |= 1u << last;
+        g_rev_tiles[letters[0] - 'A'] |= (uint64_t)1 << t;
+        board_mask |= 1u << (letters[0] - 'A') | 1u << last;
+        board_letters += n;
+        for (int k = 0; k < g_num_nbrs[t]; k++) {
+            const int u = g_nbrs[t][k];
+            if (g_dice[u] == '0') continue;
+            g_rev_nbrs[t] |= (uint64_t)1 << u;
+            follows[last] |= 1u << ((g_dice[u] >= 'A' ? g_dice[u] : g_special_dice[g_dice[u] - '0'][0]) - 'A');
+        }
+    }
+
+    reset_search();
+    for (int w = 0; w < s->num_words; w++) {
+        const int len = s->lengths[w];
+        if ((s->masks[w] & ~board_mask) || len < g_min_legal || len > board_letters) continue;
+        const char *word = s->text + s->offsets[w];
+        uint8_t need[26] = {0};
+        int k = 0;
+        while (++need[word[k] - 'A'] <= supply[word[k] - 'A'] &&
+               (k + 1 == len || (follows[word[k] - 'A'] >> (word[k + 1] - 'A') & 1))) {
+            k++;
+            if (k == len) break;
+        }
+        if (k < len || !rev_trace(word, ~(uint64_t)0, 0)) continue;
+        memcpy(g_word, word, len);
+        if (!add_word(len, w)) return false;
+    }
+    return true;
 }
 
 /**
- * Fast heuristic: check board quality before expensive word finding
- * 
- * Performs quick checks to identify boards that are unlikely to have
- * many words, avoiding the expensive recursive word-finding algorithm.
- * 
- * HEURISTICS CHECKED:
- * 1. Vowel/consonant ratio (target: 30-40% vowels)
- * 2. Common letter presence (S, R, T, N, L are word-builders)
- * 3. Letter distribution (avoid clustering)
- * 4. Special patterns (QU positioning, common endings)
- * 
- * @return true if board looks promising, false if likely poor
+ * ENGINE SELECTION
+ *
+ * Which engine is faster depends on the dictionary and the board size:
+ * with words.dat, find_words() is faster at every size, so read_dawg()
+ * makes ENGINE_DAWG the default; with a kids' list of a few thousand
+ * words, the reverse engine can be, so load_word_list() makes it
+ * ENGINE_AUTO. ENGINE_AUTO calibrates per board size: the first
+ * ENGINE_CALIBRATION_SOLVES solves of each engine (alternating) are timed
+ * whole, including the DAWG search that puts an accepted board's words in
+ * find_words() order, and later solves use the one with the lower total.
+ * Timings are per thread and start over when the dictionary changes. The
+ * word store is built before timing starts.
  */
-static bool board_looks_promising() {
-    const int board_size = g_board_width * g_board_height;
+#define ENGINE_CALIBRATION_SOLVES 16
+
+struct engine_timing {
+    unsigned int generation;     // g_dict_generation the timings are for
+    int solves[2];               // By engine - ENGINE_DAWG
+    long long ns[2];
+};
+
+static int g_dict_engine = ENGINE_DAWG;                          // ENGINE_DEFAULT for this dictionary
+static THREAD_LOCAL int g_solver_engine = ENGINE_DEFAULT;
+static THREAD_LOCAL struct engine_timing g_engine_timing[7][7];   // By width, height
+static atomic_uint g_dict_generation = 1;                         // Zeroed timings are stale
+
+static long long monotonic_ns();
+
+void set_solver_engine(int engine) {
+    g_solver_engine = engine >= ENGINE_AUTO && engine <= ENGINE_REVERSE ? engine : ENGINE_DEFAULT;
+}
+
+static struct engine_timing *engine_timing(int width, int height) {
+    struct engine_timing *e = &g_engine_timing[height][width];
+    const unsigned int generation = atomic_load_explicit(&g_dict_generation, memory_order_relaxed);
+    if (e->generation != generation) {
+        memset(e, 0, sizeof(*e));
+        e->generation = generation;
+    }
+    return e;
+}
+
+int get_solver_engine(int width, int height) {
+    const int engine = g_solver_engine == ENGINE_DEFAULT ? g_dict_engine : g_solver_engine;
+    if (engine != ENGINE_AUTO) return engine;
+    if (width < 1 || width > 6 || height < 1 || height > 6) return ENGINE_AUTO;
+    const struct engine_timing *e = engine_timing(width, height);
+    if (e->solves[1] < ENGINE_CALIBRATION_SOLVES) return ENGINE_AUTO;
+    return e->ns[0] <= e->ns[1] ? ENGINE_DAWG : ENGINE_REVERSE;
+}
+
+// Engine for the next solve; timed while calibrating
+static int next_engine(bool *timed) {
+    const int engine = get_solver_engine(g_board_width, g_board_height);
+    *timed = engine == ENGINE_AUTO;
+    if (!*timed) return engine;
+    const struct engine_timing *e = engine_timing(g_board_width, g_board_height);
+    return e->solves[0] > e->solves[1] ? ENGINE_REVERSE : ENGINE_DAWG;
+}
+
+// Solve the current board with one engine, checking every constraint
+static bool solve_current(int engine) {
+    // Productive tiles first when a maximum can cut the search short
+    // (the reverse engine's order is the dictionary's)
+    const bool ordered = engine == ENGINE_DAWG &&
+                         (g_max_words != INT32_MAX || g_max_score != INT32_MAX ||
+                          g_max_longest != INT32_MAX || g_max_difficulty != INT64_MAX);
+    if (ordered) {
+        order_exploration();
+    } else {
+        default_exploration();
+    }
+
+    // Try starting words from every position on the board
+    if (!(engine == ENGINE_REVERSE ? reverse_search() : search_board())) {
+        PROBE5(solve_end, g_board_id, 0, g_num_words, g_score, g_longest);
+        return false;  // Constraint violation during search
+    }
+    PROBE5(solve_end, g_board_id, 1, g_num_words, g_score, g_longest);
+    
+    // Validate final results against all constraints (recording which one
+    // failed for fill_board telemetry)
+    if (g_num_words < g_min_words) {
+        g_fail_reason = CONSTRAINT_WORDS;
+        return false;
+    }
+    if (g_score < g_min_score) {
+        g_fail_reason = CONSTRAINT_SCORE;
+        return false;
+    }
+    if (g_longest < g_min_longest || g_longest > g_max_longest) {
+        g_fail_reason = CONSTRAINT_LONGEST;
+        return false;
+    }
+    if (g_difficulty < g_min_difficulty) {
+        g_fail_reason = CONSTRAINT_DIFFICULTY;
+        return false;
+    }
+
+    // Words are listed in the order they were found: search an accepted
+    // board again in the default order so the list doesn't depend on the
+    // order or the engine
+    if (ordered || engine == ENGINE_REVERSE) {
+        default_exploration();
+        search_board();
+    }
+    return true;  // Board meets all requirements
+}
+
+/**
+ * Find all valid words on the current board
+ * 
+ * Entry point for word finding. Initiates recursive search from every
+ * position on the board and validates final results against constraints.
+ * 
+ * PROCESS:
+ * 1. Reset hash table and counters for new search
+ * 2. Try starting a word from each board position (or, with the reverse
+ *    engine, look for each dictionary word; see ENGINE SELECTION)
+ * 3. find_words() recursively explores all possible paths
+ * 4. Check final board statistics against min/max constraints
+ * 
+ * @return true if board meets all word/score/length requirements, false otherwise
+ */
+bool find_all_words() {
+    STAT_INC(solves);
+    PROBE1(solve_start, g_board_id);
+
+    bool timed;
+    const int engine = next_engine(&timed);
+    if (!timed) return solve_current(engine);
+
+    struct engine_timing *e = engine_timing(g_board_width, g_board_height);
+    if (engine == ENGINE_REVERSE) word_store();
+    const long long start = monotonic_ns();
+    const bool ok = solve_current(engine);
+    e->ns[engine - ENGINE_DAWG] += monotonic_ns() - start;
+    e->solves[engine - ENGINE_DAWG]++;
+    return ok;
+}
+
+/**
+ * Fast heuristic: check board quality before expensive word finding
+ * 
+ * Performs quick checks to identify boards that are unlikely to have
+ * many words, avoiding the expensive recursive word-finding algorithm.
+ * 
+ * HEURISTICS CHECKED:
+ * 1. Vowel/consonant ratio (target: 30-40% vowels)
+ * 2. Common letter presence (S, R, T, N, L are word-builders)
+ * 3. Letter distribution (avoid clustering)
+ * 4. Special patterns (QU positioning, common endings)
+ * 
+ * @return true if board looks promising, false if likely poor
+ */
+static bool board_looks_promising() {
+    const int board_size = g_board_width * g_board_height;
     int vowel_count = 0;
     int common_letters = 0;  // Count of S, R, T, N, L
     int special_chars = 0;   // Count of multi-letter dice (1-5)
@@ -589,6 +1712,427 @@ static bool board_looks_promising() {
     return true;  // Board looks promising
 }
 
+/**
+ * RELAXED BOUND PREFILTER
+ *
+ * Allowing a word's path to revisit tiles can only add words, so the words
+ * spelled by walks (rather than paths) bound the board's true word count,
+ * score and longest word from above. That bound needs no per-path state: a
+ * DAWG prefix is reachable on a set of end tiles, and extending it by one
+ * letter maps that set to the neighbors of its tiles that show the letter.
+ * With the board as one 64-bit bitboard per letter, each step is a few
+ * shifts and masks covering every start tile at once, and a DFS over the
+ * DAWG visits each prefix once instead of once per board path.
+ *
+ * Digraph tiles (QU, TH ...) consume two letters, so a prefix carries two
+ * sets: "full" tiles, whose letters are all used, and "half" tiles, where
+ * only the first letter of a digraph is; a half tile can only be finished
+ * in place by its second letter.
+ *
+ * fill_board() runs it after the heuristics, before find_all_words(): a
+ * board whose bound can't reach g_min_words, g_min_score or g_min_longest
+ * can't meet them either, so rejecting it is always safe. The walk stops
+ * as soon as the bound clears every minimum, so boards that pass cost
+ * less than a solve, but not nothing: when it has rejected under 1 in 8
+ * of the boards it screened (judged after PREFILTER_TRIAL), fill_board()
+ * stops using it for that call. enable_fill_prefilter(false) turns it off.
+ */
+#define PREFILTER_TRIAL 64       // Attempts before judging the prefilter's reject rate
+
+static THREAD_LOCAL bool g_prefilter_off;
+static THREAD_LOCAL uint64_t g_pf_single[26];       // Single-letter tiles by letter
+static THREAD_LOCAL uint64_t g_pf_first[26];        // Digraph tiles by first letter
+static THREAD_LOCAL uint64_t g_pf_second[26];       // Digraph tiles by second letter
+static THREAD_LOCAL uint64_t g_pf_not_left, g_pf_not_right, g_pf_all;
+static THREAD_LOCAL int g_pf_words, g_pf_score, g_pf_longest;
+
+void enable_fill_prefilter(bool on) {
+    g_prefilter_off = !on;
+}
+
+// Tiles adjacent to any tile of set (king moves)
+static inline uint64_t pf_neighbors(uint64_t set) {
+    const int w = g_board_width;
+    const uint64_t sideways = (set & g_pf_not_right) << 1 | (set & g_pf_not_left) >> 1;
+    const uint64_t row = set | sideways;
+    return (sideways | row << w | row >> w) & g_pf_all;
+}
+
+static inline bool pf_enough() {
+    return g_pf_words >= g_min_words && g_pf_score >= g_min_score && g_pf_longest >= g_min_longest;
+}
+
+/**
+ * Walk one DAWG sibling list given the tiles the prefix can end on
+ *
+ * @return true once the bound clears every minimum (stop walking)
+ */
+static bool pf_walk(unsigned int i, uint64_t reach, uint64_t half, int len) { // NOLINT(*-no-recursion)
+    const uint64_t next_to = len ? pf_neighbors(reach) : g_pf_all;
+    for (; i; i = DAWG_NEXT(dawg, i)) {
+        const int c = DAWG_LETTER(dawg, i) - 'A';
+        const uint64_t full = (next_to & g_pf_single[c]) | (half & g_pf_second[c]);
+        const uint64_t started = next_to & g_pf_first[c];
+        if (!(full | started)) continue;
+
+        if (full && DAWG_EOW(dawg, i) && len + 1 >= g_min_legal) {
+            g_pf_words++;
+            g_pf_score += g_score_counts[len + 1];
+            if (len + 1 > g_pf_longest) g_pf_longest = len + 1;
+            if (pf_enough()) return true;
+        }
+        const unsigned int child = DAWG_CHILD(dawg, i);
+        if (child && pf_walk(child, full, started, len + 1)) return true;
+    }
+    return false;
+}
+
+// The first minimum the bound fell short of (for telemetry)
+static enum constraint_id pf_short_of() {
+    if (g_pf_words < g_min_words) return CONSTRAINT_WORDS;
+    if (g_pf_score < g_min_score) return CONSTRAINT_SCORE;
+    return CONSTRAINT_LONGEST;
+}
+
+/**
+ * @return false if the board provably can't meet the minimum constraints
+ */
+static bool relaxed_bound_ok() {
+    const int w = g_board_width, n = g_board_width * g_board_height;
+    memset(g_pf_single, 0, sizeof(g_pf_single));
+    memset(g_pf_first, 0, sizeof(g_pf_first));
+    memset(g_pf_second, 0, sizeof(g_pf_second));
+    g_pf_all = n == 64 ? ~0ull : (1ull << n) - 1;
+    g_pf_not_left = g_pf_not_right = g_pf_all;
+    for (int t = 0; t < n; t++) {
+        const uint64_t bit = 1ull << t;
+        if (t % w == 0) g_pf_not_left &= ~bit;
+        if (t % w == w - 1) g_pf_not_right &= ~bit;
+        const char face = g_dice[t];
+        if (face >= 'A') {
+            g_pf_single[face - 'A'] |= bit;
+        } else if (face > '0') {
+            g_pf_first[g_special_dice[face - '0'][0] - 'A'] |= bit;
+            g_pf_second[g_special_dice[face - '0'][1] - 'A'] |= bit;
+        }
+    }
+    g_pf_words = g_pf_score = g_pf_longest = 0;
+    return pf_enough() || pf_walk(1, 0, 0, 0);
+}
+
+/**
+ * PATH-SAMPLING ESTIMATOR
+ *
+ * An unbiased estimate of a board's word count and score from random walks
+ * instead of the full search (Knuth's tree-size estimator). A sample starts
+ * on a random tile whose letter begins a word and keeps stepping to a random
+ * unused neighbor that extends a DAWG prefix, until none does. Its weight is
+ * the product of the number of choices at each step, i.e. the inverse
+ * probability of the path, so summing weight over the words it spells gives
+ * an unbiased estimate of the number of (path, word) pairs on the board.
+ *
+ * A word spelled by several paths would be counted once per path; dividing
+ * each contribution by the word's path count (a search constrained to that
+ * one word, so cheap) makes the estimate one of distinct words, matching
+ * find_all_words(). Score is the same sum weighted by word length.
+ *
+ * The estimate's variance comes from the spread of the samples, so its
+ * accuracy is known for a fixed sample budget. Walks are stratified by
+ * start tile (see estimate_current()). The longest word spelled by
+ * any sample is a real word on the board, a lower bound on g_longest.
+ *
+ * fill_board() uses it for optional early rejection (set_fill_estimator()):
+ * a board whose estimate plus z standard errors is below g_min_words or
+ * g_min_score is skipped. Unlike the prefilter this can reject a board that
+ * would have passed, at a rate set by z, so it is off by default. The walks
+ * draw from their own generator, seeded by get_words(), and never disturb
+ * random().
+ */
+static THREAD_LOCAL int g_est_samples;         // Per board in fill_board(); 0 = off
+static THREAD_LOCAL double g_est_z;
+static THREAD_LOCAL uint64_t g_est_rng = 1;
+static THREAD_LOCAL struct board_estimate g_estimate;
+static THREAD_LOCAL uint8_t g_est_nbrs[36][8];           // Neighbors of each tile
+static THREAD_LOCAL uint8_t g_est_num_nbrs[36];
+
+void set_fill_estimator(int samples, double z) {
+    g_est_samples = samples > 0 ? samples : 0;
+    g_est_z = z;
+}
+
+// splitmix64: fast, and any seed (including 0) is fine
+static inline uint64_t est_random() {
+    uint64_t z = (g_est_rng += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Follow one tile's letter(s) from DAWG sibling list i
+ *
+ * @return The node reached (its letter is the tile's last), or 0
+ */
+static inline unsigned int est_follow(unsigned int i, char face) {
+    if (face >= 'A') {
+        while (i && DAWG_LETTER(dawg, i) != face) i = DAWG_NEXT(dawg, i);
+        return i;
+    }
+    const char *pair = g_special_dice[face - '0'];
+    while (i && DAWG_LETTER(dawg, i) != pair[0]) i = DAWG_NEXT(dawg, i);
+    if (!i) return 0;
+    i = DAWG_CHILD(dawg, i);
+    while (i && DAWG_LETTER(dawg, i) != pair[1]) i = DAWG_NEXT(dawg, i);
+    return i;
+}
+
+/**
+ * Number of tile paths spelling g_word[at..len) that start on tile t
+ */
+static int est_count_paths(int t, int at, int len, uint64_t used) { // NOLINT(*-no-recursion)
+    const char face = g_dice[t];
+    if (face >= 'A') {
+        if (g_word[at] != face) return 0;
+        at++;
+    } else {
+        const char *pair = g_special_dice[face - '0'];
+        if (at + 1 >= len || g_word[at] != pair[0] || g_word[at + 1] != pair[1]) return 0;
+        at += 2;
+    }
+    if (at == len) return 1;
+
+    used |= 1ull << t;
+    int paths = 0;
+    for (int d = 0; d < g_est_num_nbrs[t]; d++) {
+        const int n = g_est_nbrs[t][d];
+        if (!(used & (1ull << n))) paths += est_count_paths(n, at, len, used);
+    }
+    return paths;
+}
+
+/**
+ * One random walk from tile t (DAWG node: its letters) to a dead end
+ *
+ * @return Sum of weight / paths over the words spelled on the way (score
+ *         and the longest word's length go to *score and *longest)
+ */
+static double est_walk(int t, unsigned int node, double *score, int *longest) {
+    const int num_tiles = g_board_width * g_board_height;
+    double weight = 1, words = 0;
+    int len = 0;
+    uint64_t used = 0;
+    int tiles[8];
+    unsigned int nodes[8];
+
+    *score = 0;
+    for (;;) {
+        const char face = g_dice[t];
+        if (face >= 'A') {
+            g_word[len++] = face;
+        } else {
+            g_word[len++] = g_special_dice[face - '0'][0];
+            g_word[len++] = g_special_dice[face - '0'][1];
+        }
+        used |= 1ull << t;
+
+        if (DAWG_EOW(dawg, node) && len >= g_min_legal) {
+            int paths = 0;
+            for (int start = 0; start < num_tiles; start++) paths += est_count_paths(start, 0, len, 0);
+            words += weight / paths;
+            *score += weight * g_score_counts[len] / paths;
+            if (len > *longest) *longest = len;
+        }
+
+        // Next step: unused neighbors that extend the prefix
+        const unsigned int list = DAWG_CHILD(dawg, node);
+        int choices = 0;
+        for (int d = 0; list && d < g_est_num_nbrs[t]; d++) {
+            const int n = g_est_nbrs[t][d];
+            if (used & (1ull << n)) continue;
+            const unsigned int next = est_follow(list, g_dice[n]);
+            if (next) {
+                tiles[choices] = n;
+                nodes[choices++] = next;
+            }
+        }
+        if (!choices) return words;
+        const int pick = (int)(est_random() % choices);
+        weight *= choices;
+        t = tiles[pick];
+        node = nodes[pick];
+    }
+}
+
+/**
+ * Estimate the current board (g_dice etc.) from about samples random walks
+ *
+ * The walks are stratified by start tile: each tile whose letters begin a
+ * word gets the same number of walks (at least 2, so samples is rounded
+ * up), and the estimate is the sum of the per-tile means. That removes the
+ * variance of choosing a start tile at random, a large share of the total.
+ */
+static void estimate_current(int samples, struct board_estimate *out) {
+    const int num_tiles = g_board_width * g_board_height;
+    int num_starts = 0;
+
+    for (int t = 0; t < num_tiles; t++) {
+        const int y = t / g_board_width, x = t % g_board_width;
+        g_est_num_nbrs[t] = 0;
+        for (int d = 0; d < 8; d++) {
+            const int ny = y + g_deltas[d][0];
+            const int nx = x + g_deltas[d][1];
+            if (ny >= 0 && ny <= g_max_y && nx >= 0 && nx <= g_max_x) {
+                g_est_nbrs[t][g_est_num_nbrs[t]++] = ny * g_board_width + nx;
+            }
+        }
+        if (est_follow(1, g_dice[t])) num_starts++;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (!num_starts) return;
+    const int per_tile = samples > 2 * num_starts ? (samples + num_starts - 1) / num_starts : 2;
+    for (int t = 0; t < num_tiles; t++) {
+        const unsigned int node = est_follow(1, g_dice[t]);
+        if (!node) continue;
+        double sum_words = 0, sum_words2 = 0, sum_score = 0, sum_score2 = 0;
+        for (int s = 0; s < per_tile; s++) {
+            double score;
+            const double words = est_walk(t, node, &score, &out->longest_seen);
+            sum_words += words;
+            sum_words2 += words * words;
+            sum_score += score;
+            sum_score2 += score * score;
+        }
+        // Add this tile's mean, and its variance (sample variance / walks)
+        const double words = sum_words / per_tile, score = sum_score / per_tile;
+        out->words += words;
+        out->score += score;
+        out->words_var += fmax(0, (sum_words2 - sum_words * words) / (per_tile - 1) / per_tile);
+        out->score_var += fmax(0, (sum_score2 - sum_score * score) / (per_tile - 1) / per_tile);
+    }
+    out->samples = per_tile * num_starts;
+}
+
+// Upper confidence bound on words or score below the minimum
+static enum constraint_id est_short_of() {
+    estimate_current(g_est_samples, &g_estimate);
+    if (g_estimate.words + g_est_z * sqrt(g_estimate.words_var) < g_min_words) return CONSTRAINT_WORDS;
+    if (g_estimate.score + g_est_z * sqrt(g_estimate.score_var) < g_min_score) return CONSTRAINT_SCORE;
+    return CONSTRAINT_NONE;
+}
+
+/**
+ * FILL_BOARD TELEMETRY (runtime optional)
+ *
+ * When enabled, fill_board() classifies every attempt by the stage that
+ * ended it (heuristic, relaxed-bound prefilter, path-sampling estimate,
+ * fail-fast max violation, min violation at the end, or accepted) and
+ * which constraint was responsible, and buckets its wall time and nodes
+ * visited into log2 histograms. Used to see *why* a slow profile is slow
+ * before tuning heuristics or feasibility estimates.
+ *
+ * Disabled, it costs one predictable branch per attempt. Nodes visited
+ * come from the solver counters, so they're only filled in STATS builds.
+ */
+static THREAD_LOCAL bool g_telemetry_on;
+static THREAD_LOCAL struct fill_telemetry g_telemetry;
+
+void enable_fill_telemetry(bool on) {
+    g_telemetry_on = on;
+}
+
+void get_fill_telemetry(struct fill_telemetry *out) {
+    *out = g_telemetry;
+#ifdef LIBWORDS_STATS
+    out->have_nodes = true;
+#endif
+}
+
+void reset_fill_telemetry(void) {
+    memset(&g_telemetry, 0, sizeof(g_telemetry));
+}
+
+static long long monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline int log2_bucket(long long v) {
+    int b = v > 1 ? 63 - __builtin_clzll(v) : 0;
+    return b < TELEMETRY_BUCKETS ? b : TELEMETRY_BUCKETS - 1;
+}
+
+static void record_attempt(enum attempt_outcome outcome, enum constraint_id reason,
+                           long long start_ns, long long start_nodes) {
+    const long long elapsed = monotonic_ns() - start_ns;
+    g_telemetry.attempts++;
+    g_telemetry.outcomes[outcome]++;
+    g_telemetry.by_constraint[outcome][reason]++;
+    g_telemetry.time_ns[outcome] += elapsed;
+    g_telemetry.time_hist[outcome][log2_bucket(elapsed)]++;
+#ifdef LIBWORDS_STATS
+    const long long nodes = g_stats.nodes_visited - start_nodes;
+    g_telemetry.nodes[outcome] += nodes;
+    g_telemetry.nodes_hist[outcome][log2_bucket(nodes)]++;
+#else
+    (void)start_nodes;
+#endif
+}
+
+/**
+ * FILL_BOARD PROGRESS (runtime optional)
+ *
+ * A host can ask fill_board() to report every every_tries attempts and/or
+ * every every_ms milliseconds (0 disables either trigger): tries so far,
+ * the attempt rate, and the best near-miss, the highest word count, score
+ * and longest word seen on any board that was searched to the end. A
+ * nonzero return from the callback cancels the fill.
+ *
+ * Unset, it costs one predictable branch per attempt, like telemetry.
+ * Python passes a ctypes CFUNCTYPE callback: ctypes dropped the GIL for
+ * the get_words() call and takes it back for the callback's duration, so
+ * a fill on a worker thread doesn't stall the UI between reports.
+ */
+static THREAD_LOCAL fill_progress_fn g_progress_fn;
+static THREAD_LOCAL void *g_progress_user;
+static THREAD_LOCAL int g_progress_tries;
+static THREAD_LOCAL long long g_progress_ns;
+
+void set_fill_progress(fill_progress_fn fn, void *user, int every_tries, int every_ms) {
+    g_progress_fn = fn;
+    g_progress_user = user;
+    g_progress_tries = every_tries > 0 ? every_tries : 0;
+    g_progress_ns = every_ms > 0 ? every_ms * 1000000LL : 0;
+}
+
+/**
+ * Update near-miss stats after an attempt and report if one is due
+ *
+ * @return true if the callback asked to cancel
+ */
+static bool report_progress(struct fill_progress *p, long long start_ns, long long *next_ns,
+                            bool searched) {
+    if (searched) {
+        if (g_num_words > p->best_words) p->best_words = g_num_words;
+        if (g_score > p->best_score) p->best_score = g_score;
+        if (g_longest > p->best_longest) p->best_longest = g_longest;
+    }
+    bool due = g_progress_tries && p->tries % g_progress_tries == 0;
+    long long now = 0;
+    if (g_progress_ns) {
+        now = monotonic_ns();
+        due |= now >= *next_ns;
+    }
+    if (!due) return false;
+
+    if (!now) now = monotonic_ns();
+    if (g_progress_ns) *next_ns = now + g_progress_ns;
+    p->elapsed = (now - start_ns) / 1e9;
+    p->attempts_per_sec = p->elapsed > 0 ? p->tries / p->elapsed : 0;
+    return g_progress_fn(p, g_progress_user) != 0;
+}
+
 /**
  * Generate a valid board within attempt limit
  * 
@@ -600,22 +2144,85 @@ static bool board_looks_promising() {
  * performance when constraints are high.
  * 
  * @param max_tries Maximum number of board generation attempts
- * @return Number of attempts taken (1-based), or -1 if failed
+ * @return Number of attempts taken (1-based), or -1 if failed or cancelled
  */
 int fill_board(int max_tries) {
     int count = 0;
+    struct fill_progress progress = {0};
+    long long progress_start = 0, progress_next = 0;
+    // Any board with a word passes trivial minimums
+    const bool prefilter = !g_prefilter_off &&
+                           (g_min_words > 1 || g_min_score > 1 || g_min_longest > g_min_legal);
+    int pf_runs = 0, pf_rejects = 0;
+    const bool estimator = g_est_samples && (g_min_words > 1 || g_min_score > 1);
+    if (g_progress_fn) {
+        progress_start = monotonic_ns();
+        progress_next = progress_start + g_progress_ns;
+    }
+    PROBE3(fill_start, max_tries, g_board_width, g_board_height);
     while (count++ < max_tries) {
+        const bool telemetry = g_telemetry_on;
+        long long t0 = 0, nodes0 = 0;
+        if (telemetry) {
+            t0 = monotonic_ns();
+#ifdef LIBWORDS_STATS
+            nodes0 = g_stats.nodes_visited;
+#endif
+        }
+
         make_dice();           // Generate random board
+        PROBE2(attempt, g_board_id, count);
         
         // Fast rejection: skip expensive word finding if board looks poor
         if ((g_min_longest >= 11 || g_max_words > 400) && !board_looks_promising()) {
+            PROBE1(heuristic_reject, g_board_id);
+            if (telemetry) record_attempt(ATTEMPT_HEURISTIC, CONSTRAINT_NONE, t0, nodes0);
+            if (g_progress_fn) {
+                progress.tries = count;
+                if (report_progress(&progress, progress_start, &progress_next, false)) break;
+            }
             continue;          // Try another board without word analysis
         }
         
-        if (find_all_words()) { // Expensive check if it meets requirements
+        // Screening with an upper bound on what the exact search can find,
+        // dropped for the rest of the fill if it hardly ever rejects
+        if (prefilter && (pf_runs++ < PREFILTER_TRIAL || pf_rejects * 8 >= pf_runs) && !relaxed_bound_ok()) {
+            pf_rejects++;
+            if (telemetry) record_attempt(ATTEMPT_PREFILTER, pf_short_of(), t0, nodes0);
+            if (g_progress_fn) {
+                progress.tries = count;
+                if (report_progress(&progress, progress_start, &progress_next, false)) break;
+            }
+            continue;
+        }
+
+        // Optional statistical screen: may reject a board that would pass
+        enum constraint_id short_of;
+        if (estimator && (short_of = est_short_of()) != CONSTRAINT_NONE) {
+            if (telemetry) record_attempt(ATTEMPT_ESTIMATE, short_of, t0, nodes0);
+            if (g_progress_fn) {
+                progress.tries = count;
+                if (report_progress(&progress, progress_start, &progress_next, false)) break;
+            }
+            continue;
+        }
+
+        const bool found = find_all_words();  // Expensive check if it meets requirements
+        if (telemetry) {
+            record_attempt(found ? ATTEMPT_ACCEPTED
+                                 : g_board_failed ? ATTEMPT_MAX_VIOLATION : ATTEMPT_MIN_VIOLATION,
+                           g_fail_reason, t0, nodes0);
+        }
+        if (found) {
+            PROBE2(fill_end, count, g_board_id);
             return count;      // Success: return attempt count
         }
+        if (g_progress_fn) {
+            progress.tries = count;
+            if (report_progress(&progress, progress_start, &progress_next, !g_board_failed)) break;
+        }
     }
+    PROBE2(fill_end, -1, g_board_id);
     return -1;  // Failed to generate valid board within limit
 }
 
@@ -679,6 +2286,7 @@ char **get_words(
     char **dice_simple
 ) {
     srandom(random_seed);
+    g_est_rng = (uint64_t)random_seed;
     if (width * height > 36) FATAL2("Oops", "Board too big");
 
     // Set up global board state
@@ -695,6 +2303,11 @@ char **get_words(
     g_min_longest = min_longest;
     g_max_longest = max_longest == -1 ? INT32_MAX : max_longest;
     g_min_legal = min_legal;
+    // Difficulty limits only mean something with word weights loaded; in
+    // weight units, bounds match get_difficulty()'s rounding to bits
+    g_min_difficulty = g_word_weights ? (long long)g_req_min_difficulty * WORD_PROB_SCALE - WORD_PROB_SCALE / 2 : 0;
+    g_max_difficulty = g_word_weights && g_req_max_difficulty != -1
+                       ? (long long)g_req_max_difficulty * WORD_PROB_SCALE + WORD_PROB_SCALE / 2 - 1 : INT64_MAX;
 
     int tries = fill_board(max_tries);
     if (tries == -1) return NULL;
@@ -728,7 +2341,7 @@ char **restore_game(
     int score_counts[],
     int width,
     int height,
-    Dice dice
+    char *dice
 ) {
     // Set up global board state
     g_score_counts = score_counts;
@@ -743,7 +2356,10 @@ char **restore_game(
     g_min_longest = 0;
     g_max_longest = INT32_MAX;
     g_min_legal = 0;
+    g_min_difficulty = 0;
+    g_max_difficulty = INT64_MAX;
     strcpy(g_dice, dice);
+    g_board_id++;
 
     find_all_words();
     bws_btree_to_array();
@@ -751,3 +2367,739 @@ char **restore_game(
 
     return g_word_array;
 }
+
+/**
+ * Solve a specific board for its totals only
+ *
+ * Like restore_game(), but honours min_legal and skips building the word
+ * array, for analysis tools that solve many boards and only need the
+ * counts (see board_stats.c).
+ *
+ * @param score_counts Points per word length
+ * @param width Board width
+ * @param height Board height
+ * @param dice Exact board configuration as string
+ * @param min_legal Minimum word length to count
+ * @param[out] out Word count, score and longest word length
+ */
+
+void solve_board(
+    int score_counts[],
+    int width,
+    int height,
+    const char *dice,
+    int min_legal,
+    struct board_totals *out
+) {
+    if (width * height > 36) FATAL2("Oops", "Board too big");
+
+    // Set up global board state
+    g_score_counts = score_counts;
+    g_board_width = width;
+    g_board_height = height;
+    g_max_x = width - 1;
+    g_max_y = height - 1;
+    g_min_words = 0;
+    g_max_words = INT32_MAX;
+    g_min_score = 0;
+    g_max_score = INT32_MAX;
+    g_min_longest = 0;
+    g_max_longest = INT32_MAX;
+    g_min_legal = min_legal;
+    g_min_difficulty = 0;
+    g_max_difficulty = INT64_MAX;
+    strcpy(g_dice, dice);
+    g_board_id++;
+
+    find_all_words();
+    out->words = g_num_words;
+    out->score = g_score;
+    out->longest = g_longest;
+}
+
+/**
+ * Estimate a specific board's word count and score by path sampling
+ *
+ * See PATH-SAMPLING ESTIMATOR. The same seed gives the same estimate.
+ *
+ * @param score_counts Points per word length
+ * @param width Board width
+ * @param height Board height
+ * @param dice Exact board configuration as string
+ * @param min_legal Minimum word length to count
+ * @param samples Random walks to take (the cost, and 1/variance)
+ * @param seed Seed for the walks
+ * @param[out] out Estimates, their variances and the longest word seen
+ */
+
+void estimate_board(
+    int score_counts[],
+    int width,
+    int height,
+    const char *dice,
+    int min_legal,
+    int samples,
+    uint64_t seed,
+    struct board_estimate *out
+) {
+    if (width * height > 36) FATAL2("Oops", "Board too big");
+
+    g_score_counts = score_counts;
+    g_board_width = width;
+    g_board_height = height;
+    g_max_x = width - 1;
+    g_max_y = height - 1;
+    g_min_legal = min_legal;
+    strcpy(g_dice, dice);
+    g_board_id++;
+    g_est_rng = seed;
+
+    estimate_current(samples, out);
+}
+
+/**
+ * Word IDs of the words found by the last solve in this thread
+ *
+ * @param[out] ids Room for the word count of that solve (at most MAX_WORDS)
+ * @return Number of IDs written
+ */
+int get_word_ids(int *ids) {
+    for (int n = 0; n < used_count; n++) ids[n] = word_to_id(hash_table[used_indices[n]]);
+    return used_count;
+}
+
+/**
+ * Difficulty constraints for the following get_words() calls in this
+ * thread, in bits like get_difficulty(). Ignored until load_word_weights()
+ * succeeds.
+ *
+ * @param min_difficulty Minimum difficulty index
+ * @param max_difficulty Maximum difficulty index (-1 for unlimited)
+ */
+void set_difficulty_limits(int min_difficulty, int max_difficulty) {
+    g_req_min_difficulty = min_difficulty;
+    g_req_max_difficulty = max_difficulty;
+}
+
+/**
+ * @return Difficulty index of the last board solved in this thread, in
+ *         bits, or -1 without word weights
+ */
+int get_difficulty(void) {
+    if (!g_word_weights) return -1;
+    return (int)((g_difficulty + WORD_PROB_SCALE / 2) / WORD_PROB_SCALE);
+}
+
+/**
+ * INCREMENTAL SOLVER
+ *
+ * For exhaustive enumeration (board_enum.c), where consecutive boards
+ * differ in a single tile. Instead of a set of found words it keeps, per
+ * word, the number of board paths spelling it; a word is on the board
+ * while its count is positive. Changing tile t only affects paths through
+ * t, so those are subtracted with the old face and added with the new one
+ * (in one walk that branches on reaching t), and every other path is left
+ * alone.
+ *
+ * Paths through t are found by the usual DFS from every start tile, pruned
+ * with g_reach, which packs two facts per DAWG node: a mask of every letter
+ * that occurs in that sibling list or anywhere below it, and the most
+ * letters a word can still add from there. Until a path has used t, a
+ * branch whose continuations never contain t's (first) letter, or that is
+ * further from t (in king moves) than it has letters left, can't reach t.
+ *
+ * incr_init() builds g_reach once, after read_dawg() and before starting
+ * threads. The rest of the state is per thread in a LIBWORDS_REENTRANT
+ * build and is separate from the find_words() state, so solve_board() can
+ * be used alongside to cross-check.
+ */
+
+#define INCR_HASH_SIZE 32768         // Power of two; rebuilt when half full
+#define REACH_DONE 0x80000000u       // g_reach entry computed
+#define REACH_LETTERS 0x03FFFFFFu    // Bits 0-25: letters A-Z
+#define REACH_DEPTH_SHIFT 26         // Bits 26-29: letters left (<= MAX_WORD_LEN - 1)
+
+static uint32_t *g_reach;
+
+// Word -> path count table (open addressing; zero-count entries purged on rebuild)
+static THREAD_LOCAL char g_incr_keys[INCR_HASH_SIZE][MAX_WORD_LEN + 1];
+static THREAD_LOCAL int g_incr_paths[INCR_HASH_SIZE];
+static THREAD_LOCAL int g_incr_slots;
+
+// Board and running totals
+static THREAD_LOCAL const int *g_incr_score_counts;
+static THREAD_LOCAL int g_incr_width, g_incr_height, g_incr_min_legal;
+static THREAD_LOCAL Dice g_incr_dice;
+static THREAD_LOCAL char g_incr_word[MAX_WORD_LEN + 1];
+static THREAD_LOCAL int g_incr_words, g_incr_score;
+static THREAD_LOCAL int g_incr_by_len[MAX_WORD_LEN + 1];  // Words present per length
+
+// Current update pass
+static THREAD_LOCAL int g_incr_target;                    // Tile being changed (-1: whole board)
+static THREAD_LOCAL char g_incr_old_face, g_incr_new_face;
+static THREAD_LOCAL uint32_t g_incr_target_bit;           // First letters of both, as g_reach bits
+static THREAD_LOCAL int g_incr_target_y, g_incr_target_x;
+static THREAD_LOCAL int g_incr_sign;                      // +1 adding paths (new face), -1 removing (old)
+
+static uint32_t reach_mask(unsigned int i) { // NOLINT(*-no-recursion)
+    if (i == 0) return 0;
+    if (g_reach[i] & REACH_DONE) return g_reach[i];
+
+    const uint32_t below = reach_mask(dawg[i] >> CHILD_BIT_SHIFT);
+    const uint32_t next = (dawg[i] & EOL_BIT_MASK) ? 0 : reach_mask(i + 1);
+    uint32_t depth = below ? ((below >> REACH_DEPTH_SHIFT) & 0xF) + 1 : 1;
+    const uint32_t next_depth = (next >> REACH_DEPTH_SHIFT) & 0xF;
+    if (next_depth > depth) depth = next_depth;
+
+    const uint32_t letters = (1u << ((dawg[i] & LTR_BIT_MASK) - 'A')) | (below & REACH_LETTERS) | (next & REACH_LETTERS);
+    g_reach[i] = letters | depth << REACH_DEPTH_SHIFT | REACH_DONE;
+    return g_reach[i];
+}
+
+void incr_init(void) {
+    if (g_reach) return;
+    g_reach = calloc(dawg_nodes, sizeof(uint32_t));
+    if (!g_reach) FATAL2("Cannot allocate", "reach masks");
+    for (unsigned int i = 1; i < dawg_nodes; i++) reach_mask(i);
+}
+
+static inline uint32_t face_bit(char face) {
+    const char first = face >= 'A' ? face : g_special_dice[face - '0'][0];
+    return 1u << (first - 'A');
+}
+
+static void incr_rehash(void) {
+    static THREAD_LOCAL char keys[INCR_HASH_SIZE / 2][MAX_WORD_LEN + 1];
+    static THREAD_LOCAL int paths[INCR_HASH_SIZE / 2];
+    int live = 0;
+    for (int k = 0; k < INCR_HASH_SIZE; k++) {
+        if (g_incr_paths[k] > 0) {
+            strcpy(keys[live], g_incr_keys[k]);
+            paths[live++] = g_incr_paths[k];
+        }
+        g_incr_keys[k][0] = '\0';
+        g_incr_paths[k] = 0;
+    }
+    g_incr_slots = live;
+    for (int n = 0; n < live; n++) {
+        unsigned int index = hash_word(keys[n]) & (INCR_HASH_SIZE - 1);
+        while (g_incr_keys[index][0] != '\0') index = (index + 1) & (INCR_HASH_SIZE - 1);
+        strcpy(g_incr_keys[index], keys[n]);
+        g_incr_paths[index] = paths[n];
+    }
+    if (g_incr_slots >= INCR_HASH_SIZE / 2) FATAL2("Oops", "Too many words for incremental solver");
+}
+
+/**
+ * Add g_incr_sign paths for the word in g_incr_word, updating the totals
+ * when the word appears or disappears.
+ */
+static void incr_count(int word_len) {
+    unsigned int index = hash_word(g_incr_word) & (INCR_HASH_SIZE - 1);
+    while (g_incr_keys[index][0] != '\0' && strcmp(g_incr_keys[index], g_incr_word) != 0) {
+        index = (index + 1) & (INCR_HASH_SIZE - 1);
+    }
+    if (g_incr_keys[index][0] == '\0') {
+        strcpy(g_incr_keys[index], g_incr_word);
+        g_incr_slots++;
+    }
+
+    const int before = g_incr_paths[index];
+    g_incr_paths[index] += g_incr_sign;
+    if (before == 0) {
+        g_incr_words++;
+        g_incr_score += g_incr_score_counts[word_len];
+        g_incr_by_len[word_len]++;
+    } else if (g_incr_paths[index] == 0) {
+        g_incr_words--;
+        g_incr_score -= g_incr_score_counts[word_len];
+        g_incr_by_len[word_len]--;
+    }
+
+    if (g_incr_slots >= INCR_HASH_SIZE / 2) incr_rehash();
+}
+
+/**
+ * find_words() without constraints, counting paths instead of words, and
+ * only paths through g_incr_target (all paths when through starts true)
+ */
+static void incr_words( // NOLINT(*-no-recursion)
+        unsigned int i,
+        int word_len,
+        const int y,
+        const int x,
+        int_least64_t used,
+        bool through)
+{
+    const int tile = y * g_incr_width + x;
+    const int_least64_t mask = (int_least64_t)1 << tile;
+    if (used & mask) return;
+
+    // Stepping onto the changed tile: the path so far is shared by its old
+    // and new versions, so branch here rather than walking it twice
+    if (tile == g_incr_target && !through) {
+        g_incr_dice[tile] = g_incr_old_face;
+        g_incr_sign = -1;
+        incr_words(i, word_len, y, x, used, true);
+        g_incr_dice[tile] = g_incr_new_face;
+        g_incr_sign = +1;
+        incr_words(i, word_len, y, x, used, true);
+        return;
+    }
+
+    const char sought = g_incr_dice[tile];
+    if (sought >= 'A') {
+        while (i != 0 && (dawg[i] & LTR_BIT_MASK) != sought) {
+            i = (dawg[i] & EOL_BIT_MASK) ? 0 : i + 1;
+        }
+        if (i == 0) return;
+        g_incr_word[word_len++] = sought;
+    } else {
+        const int idx = sought - '0';
+        const char t1 = g_special_dice[idx][0];
+        const char t2 = g_special_dice[idx][1];
+        while (i != 0 && (dawg[i] & LTR_BIT_MASK) != t1) {
+            i = (dawg[i] & EOL_BIT_MASK) ? 0 : i + 1;
+        }
+        if (i == 0) return;
+        i = dawg[i] >> CHILD_BIT_SHIFT;
+        while (i != 0 && (dawg[i] & LTR_BIT_MASK) != t2) {
+            i = (dawg[i] & EOL_BIT_MASK) ? 0 : i + 1;
+        }
+        if (i == 0) return;
+        g_incr_word[word_len++] = t1;
+        g_incr_word[word_len++] = t2;
+    }
+
+    used |= mask;
+    through |= tile == g_incr_target;
+
+    if (through && (dawg[i] & EOW_BIT_MASK) && word_len >= g_incr_min_legal) {
+        g_incr_word[word_len] = '\0';
+        incr_count(word_len);
+    }
+
+    const unsigned int child = dawg[i] >> CHILD_BIT_SHIFT;
+    if (child == 0) return;
+    if (!through) {
+        const uint32_t reach = g_reach[child];
+        if (!(reach & g_incr_target_bit)) return;
+        const int dy = abs(y - g_incr_target_y), dx = abs(x - g_incr_target_x);
+        if ((int)((reach >> REACH_DEPTH_SHIFT) & 0xF) < (dy > dx ? dy : dx)) return;
+    }
+
+    for (int d = 0; d < 8; d++) {
+        const int ny = y + g_deltas[d][0];
+        const int nx = x + g_deltas[d][1];
+        if (ny >= 0 && ny < g_incr_height && nx >= 0 && nx < g_incr_width) {
+            incr_words(child, word_len, ny, nx, used, through);
+        }
+    }
+}
+
+static void incr_pass(bool all) {
+    for (int y = 0; y < g_incr_height; y++) {
+        for (int x = 0; x < g_incr_width; x++) {
+            incr_words(1, 0, y, x, 0x0, all);
+        }
+    }
+}
+
+static void incr_totals(struct board_totals *out) {
+    out->words = g_incr_words;
+    out->score = g_incr_score;
+    out->longest = 0;
+    for (int len = MAX_WORD_LEN; len > 0; len--) {
+        if (g_incr_by_len[len]) {
+            out->longest = len;
+            break;
+        }
+    }
+}
+
+/**
+ * Solve a board from scratch and remember its paths for incr_change()
+ *
+ * @param score_counts Points per word length
+ * @param width Board width
+ * @param height Board height
+ * @param dice Exact board configuration as string
+ * @param min_legal Minimum word length to count
+ * @param[out] out Word count, score and longest word length
+ */
+void incr_start(int score_counts[], int width, int height, const char *dice,
+                int min_legal, struct board_totals *out) {
+    if (width * height > 36) FATAL2("Oops", "Board too big");
+
+    memset(g_incr_keys, 0, sizeof(g_incr_keys));
+    memset(g_incr_paths, 0, sizeof(g_incr_paths));
+    memset(g_incr_by_len, 0, sizeof(g_incr_by_len));
+    g_incr_slots = 0;
+    g_incr_words = 0;
+    g_incr_score = 0;
+
+    g_incr_score_counts = score_counts;
+    g_incr_width = width;
+    g_incr_height = height;
+    g_incr_min_legal = min_legal;
+    strcpy(g_incr_dice, dice);
+
+    g_incr_target = -1;
+    g_incr_sign = +1;
+    incr_pass(true);
+    incr_totals(out);
+}
+
+/**
+ * Change one tile of the board given to incr_start() and re-solve
+ *
+ * @param tile Board position (y * width + x)
+ * @param face New face for that tile
+ * @param[out] out Word count, score and longest word length
+ */
+void incr_change(int tile, char face, struct board_totals *out) {
+    g_incr_target = tile;
+    g_incr_target_y = tile / g_incr_width;
+    g_incr_target_x = tile % g_incr_width;
+    g_incr_old_face = g_incr_dice[tile];
+    g_incr_new_face = face;
+    g_incr_target_bit = face_bit(g_incr_old_face) | face_bit(face);
+
+    incr_pass(false);
+    g_incr_dice[tile] = face;
+
+    incr_totals(out);
+}
+
+/**
+ * INTERLEAVED SOLVER
+ *
+ * A find_words() descent is a chain of dependent loads: which child list
+ * to scan next isn't known until the node just matched has been read, and
+ * with a 520KB DAWG each of those reads can be a cache miss that the core
+ * simply waits out. solve_boards() works through
+ * a batch of boards INTERLEAVE_LANES at a time. Each lane is one board's
+ * DFS kept as an explicit stack; a lane runs until it descends into a new
+ * child list, prefetches the head of that list and yields to the next
+ * lane, so one miss per lane can be in flight at once instead of one in
+ * total. Scans of a list already read (the other neighbors of a tile) hit
+ * the cache and run without yielding.
+ *
+ * Lanes keep their own word sets and totals, apart from the find_words()
+ * state. There are no constraints and no fail-fast: this is for throughput
+ * work that solves every board to the end (board_stats, corpora). Totals
+ * and word sets match solve_board() and restore_game() exactly
+ * (test_golden --engine interleaved checks it).
+ */
+#ifndef INTERLEAVE_LANES
+#define INTERLEAVE_LANES 8
+#endif
+#define LANE_BUCKETS 1024        // Power of two; chains stay short up to MAX_WORDS
+
+struct lane_frame {
+    const uint8_t *next;     // Neighbor tiles still to try from this tile
+    const uint8_t *end;
+    unsigned int list;       // DAWG list their letters are looked up in
+    int_least64_t used;      // Tiles on the path so far
+    int word_len;
+};
+
+struct lane {
+    int board;                           // Index in the batch, -1 when idle
+    int depth;
+    char first[36], second[36];          // Tile letters (second: digraphs only)
+    struct lane_frame stack[MAX_WORD_LEN + 1];
+    char word[MAX_WORD_LEN + 1];
+    int words, score, longest;
+    uint16_t head[LANE_BUCKETS];         // Word set, chained: index into found + 1
+    uint16_t chain[MAX_WORDS];
+    uint32_t hash[MAX_WORDS];
+    char found[MAX_WORDS][MAX_WORD_LEN + 1];
+};
+
+static THREAD_LOCAL struct lane g_lanes[INTERLEAVE_LANES];
+static THREAD_LOCAL uint8_t g_lane_nbrs[36][8];          // Neighbors of each tile
+static THREAD_LOCAL uint8_t g_lane_num_nbrs[36];
+static THREAD_LOCAL uint8_t g_lane_tiles[36];            // Every tile (start frame)
+static THREAD_LOCAL const int *g_lane_score_counts;
+static THREAD_LOCAL int g_lane_min_legal;
+
+static void lane_insert(struct lane *ln, int len) {
+    ln->word[len] = '\0';
+    uint32_t hash = 5381;
+    for (int k = 0; k < len; k++) hash = hash * 33 + ln->word[k];
+    uint16_t *bucket = &ln->head[hash & (LANE_BUCKETS - 1)];
+    for (int w = *bucket; w != 0; w = ln->chain[w - 1]) {
+        if (ln->hash[w - 1] == hash && strcmp(ln->found[w - 1], ln->word) == 0) {
+            STAT_INC(duplicates);
+            return;
+        }
+    }
+    if (ln->words == MAX_WORDS) FATAL2("Oops", "Too many words for interleaved solver");
+    STAT_INC(words_inserted);
+    memcpy(ln->found[ln->words], ln->word, len + 1);
+    ln->hash[ln->words] = hash;
+    ln->chain[ln->words] = *bucket;
+    *bucket = ++ln->words;
+    ln->score += g_lane_score_counts[len];
+    if (len > ln->longest) ln->longest = len;
+}
+
+static void lane_start(struct lane *ln, int board, const char *dice, int num_tiles) {
+    for (int w = 0; w < ln->words; w++) ln->head[ln->hash[w] & (LANE_BUCKETS - 1)] = 0;
+    ln->words = ln->score = ln->longest = 0;
+    ln->board = board;
+    for (int t = 0; t < num_tiles; t++) {
+        const char face = dice[t];
+        ln->first[t] = face >= 'A' ? face : g_special_dice[face - '0'][0];
+        ln->second[t] = face >= 'A' ? '\0' : g_special_dice[face - '0'][1];
+    }
+    ln->depth = 0;
+    ln->stack[0] = (struct lane_frame){g_lane_tiles, g_lane_tiles + num_tiles, 1, 0, 0};
+    STAT_INC(solves);
+}
+
+/**
+ * Advance a lane's search to its next descent
+ *
+ * Kept out of line: inlined into the round-robin loop of solve_boards()
+ * it runs about 15% slower (register pressure in the scan loop).
+ *
+ * @return false when the lane's board is fully searched
+ */
+__attribute__((noinline)) static bool lane_run(struct lane *ln) {
+    const int32_t *dawg_ptr = dawg;
+    for (;;) {
+        struct lane_frame *f = &ln->stack[ln->depth];
+        if (f->next == f->end) {
+            if (ln->depth-- == 0) return false;
+            continue;
+        }
+        const int tile = *f->next++;
+        const int_least64_t bit = (int_least64_t)1 << tile;
+        if (f->used & bit) {
+            STAT_INC(rejected_used);
+            continue;
+        }
+        STAT_INC(nodes_visited);
+
+        unsigned int i = f->list;
+        const char c1 = ln->first[tile], c2 = ln->second[tile];
+        STAT_INC(dawg_lookups);
+        while (i != 0 && (dawg_ptr[i] & LTR_BIT_MASK) != c1) {
+            STAT_INC(sibling_steps);
+            i = (dawg_ptr[i] & EOL_BIT_MASK) ? 0 : i + 1;
+        }
+        if (c2 && i != 0) {
+            i = dawg_ptr[i] >> CHILD_BIT_SHIFT;
+            STAT_INC(dawg_lookups);
+            while (i != 0 && (dawg_ptr[i] & LTR_BIT_MASK) != c2) {
+                STAT_INC(sibling_steps);
+                i = (dawg_ptr[i] & EOL_BIT_MASK) ? 0 : i + 1;
+            }
+        }
+        if (i == 0) {
+            STAT_INC(rejected_no_child);
+            continue;
+        }
+
+        int len = f->word_len;
+        ln->word[len++] = c1;
+        if (c2) ln->word[len++] = c2;
+        if ((dawg_ptr[i] & EOW_BIT_MASK) && len >= g_lane_min_legal) lane_insert(ln, len);
+
+        const unsigned int child = dawg_ptr[i] >> CHILD_BIT_SHIFT;
+        if (child == 0) continue;
+        __builtin_prefetch(&dawg_ptr[child]);
+        ln->stack[ln->depth + 1] = (struct lane_frame){
+            g_lane_nbrs[tile], g_lane_nbrs[tile] + g_lane_num_nbrs[tile], child, f->used | bit, len
+        };
+        ln->depth++;
+        return true;
+    }
+}
+
+static void lane_finish(const struct lane *ln, struct board_totals *out, char **words[]) {
+    out[ln->board] = (struct board_totals){ln->words, ln->score, ln->longest};
+    if (!words) return;
+    char **list = malloc((ln->words + 1) * sizeof(char *) + ln->words * (MAX_WORD_LEN + 1));
+    if (!list) FATAL2("Cannot allocate", "word list");
+    char *text = (char *)(list + ln->words + 1);
+    for (int w = 0; w < ln->words; w++) {
+        list[w] = strcpy(text, ln->found[w]);
+        text += strlen(text) + 1;
+    }
+    list[ln->words] = NULL;
+    words[ln->board] = list;
+}
+
+/**
+ * Solve a batch of same-sized boards with interleaved searches
+ *
+ * @param score_counts Points per word length
+ * @param width Board width
+ * @param height Board height
+ * @param dice n board configurations as strings
+ * @param n Number of boards
+ * @param min_legal Minimum word length to count
+ * @param[out] out n word counts, scores and longest word lengths
+ * @param[out] words If not NULL, n NULL-terminated word arrays, one
+ *             malloc() block each (free() them)
+ */
+void solve_boards(int score_counts[], int width, int height, const char *const dice[], int n,
+                  int min_legal, struct board_totals *out, char **words[]) {
+    const int num_tiles = width * height;
+    if (num_tiles > 36) FATAL2("Oops", "Board too big");
+
+    g_lane_score_counts = score_counts;
+    g_lane_min_legal = min_legal;
+    for (int t = 0; t < num_tiles; t++) {
+        const int y = t / width, x = t % width;
+        g_lane_tiles[t] = t;
+        g_lane_num_nbrs[t] = 0;
+        for (int d = 0; d < 8; d++) {
+            const int ny = y + g_deltas[d][0];
+            const int nx = x + g_deltas[d][1];
+            if (ny >= 0 && ny < height && nx >= 0 && nx < width) {
+                g_lane_nbrs[t][g_lane_num_nbrs[t]++] = ny * width + nx;
+            }
+        }
+    }
+
+    int next = 0, active = 0;
+    for (int l = 0; l < INTERLEAVE_LANES; l++) {
+        if (next < n) {
+            lane_start(&g_lanes[l], next, dice[next], num_tiles);
+            next++;
+            active++;
+        } else {
+            g_lanes[l].board = -1;
+        }
+    }
+    while (active) {
+        for (int l = 0; l < INTERLEAVE_LANES; l++) {
+            struct lane *ln = &g_lanes[l];
+            if (ln->board < 0 || lane_run(ln)) continue;
+            lane_finish(ln, out, words);
+            if (next < n) {
+                lane_start(ln, next, dice[next], num_tiles);
+                next++;
+            } else {
+                ln->board = -1;
+                active--;
+            }
+        }
+    }
+}
+
+/**
+ * WORD LISTS
+ *
+ * load_word_list() builds a trie from a plain word list, in the node
+ * format of words.dat (sibling lists in alphabetical order, node 1 first),
+ * so every engine and query works on it unchanged. Only prefixes are
+ * shared, not suffixes: a word list small enough to want one costs a few
+ * hundred KB at most. Lists with more letters than MAX_TRIE_NODES are
+ * refused (documented in libwords.h).
+ */
+#define MAX_TRIE_NODES (1u << 21)    // Child index must fit above CHILD_BIT_SHIFT
+
+static int cmp_words(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// Lay out the sibling list for sorted words[lo .. hi), all longer than depth
+static unsigned int build_trie_list(char **words, int lo, int hi, int depth, int32_t *nodes, unsigned int *used) { // NOLINT(*-no-recursion)
+    unsigned int node = *used;
+    for (int k = lo; k < hi; k++) {
+        if (k == lo || words[k][depth] != words[k - 1][depth]) (*used)++;
+    }
+    const unsigned int first = node;
+    for (int k = lo; k < hi; node++) {
+        const char letter = words[k][depth];
+        int end = k;
+        while (end < hi && words[end][depth] == letter) end++;
+        const bool eow = words[k][depth + 1] == '\0';   // Sorted: a word ending here comes first
+        const int below = eow ? k + 1 : k;
+        const unsigned int child = below < end ? build_trie_list(words, below, end, depth + 1, nodes, used) : 0;
+        nodes[node] = (int32_t)(child << CHILD_BIT_SHIFT | (end == hi ? EOL_BIT_MASK : 0) |
+                                (eow ? EOW_BIT_MASK : 0) | (uint32_t)letter);
+        k = end;
+    }
+    return first;
+}
+
+bool load_word_list(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+
+    char **words = NULL;
+    int num_words = 0, capacity = 0;
+    size_t letters = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        int len = 0;
+        bool ok = true;
+        for (char *c = line; *c && !isspace((unsigned char)*c); c++, len++) {
+            *c = (char)toupper((unsigned char)*c);
+            ok = ok && *c >= 'A' && *c <= 'Z';
+        }
+        if (!ok || len == 0 || len > MAX_WORD_LEN) continue;
+        line[len] = '\0';
+        if (num_words == capacity) {
+            capacity = capacity ? 2 * capacity : 1024;
+            words = realloc(words, capacity * sizeof(*words));
+            if (!words) FATAL2("Cannot allocate word list for", path);
+        }
+        words[num_words] = strdup(line);
+        if (!words[num_words]) FATAL2("Cannot allocate word list for", path);
+        num_words++;
+        letters += len;
+    }
+    fclose(f);
+
+    qsort(words, num_words, sizeof(*words), cmp_words);
+    int unique = 0;
+    for (int k = 0; k < num_words; k++) {
+        if (unique && strcmp(words[k], words[unique - 1]) == 0) {
+            free(words[k]);
+        } else {
+            words[unique++] = words[k];
+        }
+    }
+
+    // At most one node per letter, plus the unused node 0
+    int32_t *nodes = NULL;
+    unsigned int used = 1;
+    if (unique && letters + 1 < MAX_TRIE_NODES) {
+        nodes = calloc(letters + 1, sizeof(int32_t));
+        if (!nodes) FATAL2("Cannot allocate trie for", path);
+        build_trie_list(words, 0, unique, 0, nodes, &used);
+    }
+    for (int k = 0; k < unique; k++) free(words[k]);
+    free(words);
+    if (!nodes) return false;
+
+    set_dictionary(nodes, nodes, used);
+    g_dict_engine = ENGINE_AUTO;
+    return true;
+}
+
+/**
+ * Drop everything derived from the previous dictionary. Word IDs, word
+ * weights, definitions and their index, reach masks and the word store
+ * all describe one dictionary; engine timings start over.
+ */
+static void dictionary_changed(void) {
+    free(g_word_counts);
+    g_word_counts = NULL;
+    g_num_dawg_words = 0;
+    g_word_weights = NULL;     // Mappings stay: a table in use isn't unmapped
+    g_defs = NULL;
+    g_def_index = NULL;
+    free(g_reach);
+    g_reach = NULL;
+    free_word_store(atomic_exchange(&g_word_store, NULL));
+    g_dict_engine = ENGINE_DAWG;    // load_word_list() then picks ENGINE_AUTO
+    atomic_fetch_add(&g_dict_generation, 1);
+}
@@ -0,0 +1,296 @@
+#ifndef LIBWORDS_H
+#define LIBWORDS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Public interface to libwords.c for C tools and benchmarks.
+ *
+ * Python talks to the same functions through ctypes (see game.py); keep
+ * signatures here and there in step.
+ */
+
+#define MAX_WORD_LEN 16      // Longest possible word in Boggle
+
+// Dictionary
+void read_dawg(const char *path);
+
+/**
+ * Use a plain word list (one word per line, A-Z, case-insensitive) as the
+ * dictionary instead of words.dat. Word weights, definitions and the
+ * definition index are keyed to the dictionary and are dropped; call
+ * incr_init() again if the incremental solver is used. Like read_dawg(),
+ * only while no solve is running. False (dictionary unchanged) if the file
+ * can't be read, has no words, or is too big: the trie needs one node per
+ * letter and node indexes are 21 bits, so the words (duplicates included)
+ * must total under 2^21 - 1 letters, about 200k typical words.
+ */
+bool load_word_list(const char *path);
+
+/**
+ * Solving engines: ENGINE_DAWG walks the board following the dictionary,
+ * ENGINE_REVERSE filters the dictionary by the board's letters and
+ * path-checks the survivors (faster for small dictionaries). ENGINE_AUTO
+ * times both on each board size's first solves and keeps the faster one.
+ * ENGINE_DEFAULT (the initial setting) is the dictionary's choice:
+ * ENGINE_DAWG after read_dawg(), ENGINE_AUTO after load_word_list().
+ * get_solver_engine() is the engine used for a size, or ENGINE_AUTO while
+ * it is still being calibrated. Every engine returns the same word list,
+ * in the same order.
+ */
+enum solver_engine {
+    ENGINE_DEFAULT = -1,
+    ENGINE_AUTO,
+    ENGINE_DAWG,
+    ENGINE_REVERSE,
+};
+
+void set_solver_engine(int engine);
+int get_solver_engine(int width, int height);
+
+// Board generation and solving
+char **get_words(char *set[], int score_counts[], int width, int height,
+                 int min_words, int max_words, int min_score, int max_score,
+                 int min_longest, int max_longest, int min_legal, int max_tries,
+                 int random_seed, int *num_tries, char **dice_simple);
+char **restore_game(int score_counts[], int width, int height, char *dice);
+
+// Totals for one board, without the word list
+struct board_totals {
+    int words;
+    int score;
+    int longest;
+};
+
+void solve_board(int score_counts[], int width, int height, const char *dice,
+                 int min_legal, struct board_totals *out);
+
+/**
+ * Word IDs: dense 0 .. num_dawg_words() - 1, in DAWG (alphabetical) order.
+ * The lookup table is built on first use; in threaded programs call
+ * num_dawg_words() once before starting threads.
+ */
+int num_dawg_words(void);
+int word_to_id(const char *word);                // -1 if not a word
+bool id_to_word(int id, char *out);              // out: MAX_WORD_LEN + 1 bytes
+int get_word_ids(int *ids);                      // IDs found by the last solve
+
+/**
+ * Pattern queries: words matching pattern ('?' any letter, '*' any run)
+ * that can be spelled from letters ('?' = blank; NULL = any), as word IDs
+ * in alphabetical order. -1 for an invalid pattern.
+ */
+int find_matches(const char *pattern, const char *letters, int min_len, int max_len, int limit, int *ids);
+
+/**
+ * Per-word appearance table written by word_probs.c, laid out to be
+ * memory-mapped: this header, then one uint16_t per word ID holding the
+ * surprisal -log2(P(word on a random board)) in 1/WORD_PROB_SCALE bits,
+ * or WORD_PROB_NEVER if no sampled board had the word.
+ */
+#define WORD_PROB_MAGIC "LWPROB1"
+#define WORD_PROB_SCALE 2048
+#define WORD_PROB_NEVER 0xFFFF
+
+struct word_prob_header {
+    char magic[8];
+    uint32_t num_words;
+    uint32_t min_legal;
+    uint64_t boards;
+    char set[32];            // Dice set name
+};
+
+/**
+ * Board difficulty: with a word_probs table loaded as weights, every solve
+ * totals the surprisal of the words found (the difficulty index, in bits),
+ * and get_words() honours set_difficulty_limits(), failing fast on the max
+ * like max_score.
+ *
+ * load_word_weights() refuses a table whose header names a dice set other
+ * than set. The weights apply to every solve, so they are only meaningful
+ * for boards rolled from that set.
+ */
+bool load_word_weights(const char *path, const char *set);
+void set_difficulty_limits(int min_difficulty, int max_difficulty);
+int get_difficulty(void);                        // -1 without weights
+
+/**
+ * Definition store written by build_defs.py, memory-mapped by
+ * load_definitions(): this header, uint32_t block offsets [num_blocks + 1]
+ * into the blob, the preset deflate dictionary, then the blob of
+ * raw-deflated blocks, each holding block_words NUL-terminated definitions
+ * in word ID order (at most DEF_BLOCK_MAX bytes inflated).
+ */
+#define DEF_STORE_MAGIC "LWDEFS1"
+#define DEF_BLOCK_MAX 32768
+
+struct def_store_header {
+    char magic[8];
+    uint32_t num_words;
+    uint32_t block_words;    // build_defs.py uses 16
+    uint32_t num_blocks;
+    uint32_t dict_size;
+    uint32_t blob_size;
+    uint32_t reserved;
+};
+
+bool load_definitions(const char *path);
+int get_definition(int id, char *out, int size); // Length, or -1 (no store/ID)
+int get_definitions(const int *ids, int n, char *out, int size, int *offsets);
+
+/**
+ * Reverse-lookup index written by build_defs.py --index: this header,
+ * uint32_t token offsets [num_tokens + 1], uint32_t posting offsets
+ * [num_tokens + 1], the sorted tokens (padded to 4 bytes), then per token
+ * a posting list of (varint word ID delta, first position byte).
+ */
+#define DEF_INDEX_MAGIC "LWDIDX1"
+
+struct def_index_header {
+    char magic[8];
+    uint32_t num_words;
+    uint32_t num_tokens;
+    uint32_t tokens_size;
+    uint32_t postings_size;
+};
+
+bool load_definition_index(const char *path);
+int search_definitions(const char *query, int limit, int *ids); // Ranked IDs, -1 without index
+
+/**
+ * Incremental solver for enumerations that change one tile at a time.
+ * Call incr_init() once after read_dawg() (before starting threads), solve
+ * the first board with incr_start(), then incr_change() each tile.
+ */
+void incr_init(void);
+void incr_start(int score_counts[], int width, int height, const char *dice,
+                int min_legal, struct board_totals *out);
+void incr_change(int tile, char face, struct board_totals *out);
+
+/**
+ * Solve n boards of one size, several searches interleaved to overlap
+ * DAWG cache misses. Same totals (and words) as solve_board(); if words
+ * is not NULL, words[b] gets board b's words as one malloc()ed
+ * NULL-terminated array.
+ */
+void solve_boards(int score_counts[], int width, int height, const char *const dice[], int n,
+                  int min_legal, struct board_totals *out, char **words[]);
+
+/**
+ * Solver counters, compiled in only with -DLIBWORDS_STATS (make STATS=1).
+ *
+ * A DAWG "step" is one node touched: each letter lookup starts at the
+ * head of a sibling list (dawg_lookups) and every move along that list
+ * is a sibling_step.
+ */
+struct solver_stats {
+    long long solves;             // find_all_words() calls
+    long long nodes_visited;      // find_words() calls
+    long long dawg_lookups;       // Sibling-list scans started
+    long long sibling_steps;      // Moves to the next sibling during a scan
+    long long rejected_bounds;    // Neighbor candidates off the board
+    long long rejected_used;      // Neighbor tile already on the path
+    long long rejected_no_child;  // No DAWG child for the tile's letter(s)
+    long long words_inserted;     // New words added to the hash table
+    long long duplicates;         // Words found again by another path
+    long long fail_fast_exits;    // Searches stopped by a max constraint
+    long long fail_fast_depth[MAX_WORD_LEN + 1];  // ...by word length at the stop
+};
+
+/**
+ * Copy the counters accumulated since the last reset into out. Returns
+ * false (and zeroes out) when the library was built without LIBWORDS_STATS.
+ */
+bool get_solver_stats(struct solver_stats *out);
+void reset_solver_stats(void);
+
+/**
+ * fill_board() telemetry, switched on at runtime with
+ * enable_fill_telemetry(true). Every attempt is classified by the stage
+ * that ended it and, for constraint failures, by which constraint; its
+ * wall time (and, in a STATS build, nodes visited) goes into log2
+ * histograms: bucket b holds values in [2^b, 2^(b+1)), bucket 0 also 0.
+ */
+enum attempt_outcome {
+    ATTEMPT_ACCEPTED,        // Board met every constraint
+    ATTEMPT_HEURISTIC,       // Rejected by board_looks_promising()
+    ATTEMPT_PREFILTER,       // Relaxed upper bound below a minimum
+    ATTEMPT_ESTIMATE,        // Sampled estimate confidently below a minimum
+    ATTEMPT_MAX_VIOLATION,   // Fail-fast during the search
+    ATTEMPT_MIN_VIOLATION,   // Search finished short of a minimum
+    NUM_ATTEMPT_OUTCOMES
+};
+
+enum constraint_id {
+    CONSTRAINT_NONE,
+    CONSTRAINT_WORDS,
+    CONSTRAINT_SCORE,
+    CONSTRAINT_LONGEST,
+    CONSTRAINT_DIFFICULTY,
+    NUM_CONSTRAINTS
+};
+
+#define TELEMETRY_BUCKETS 40
+
+struct fill_telemetry {
+    long long attempts;
+    bool have_nodes;         // Node counts need a LIBWORDS_STATS build
+    long long outcomes[NUM_ATTEMPT_OUTCOMES];
+    long long by_constraint[NUM_ATTEMPT_OUTCOMES][NUM_CONSTRAINTS];
+    long long time_ns[NUM_ATTEMPT_OUTCOMES];
+    long long nodes[NUM_ATTEMPT_OUTCOMES];
+    long long time_hist[NUM_ATTEMPT_OUTCOMES][TELEMETRY_BUCKETS];
+    long long nodes_hist[NUM_ATTEMPT_OUTCOMES][TELEMETRY_BUCKETS];
+};
+
+void enable_fill_telemetry(bool on);
+void get_fill_telemetry(struct fill_telemetry *out);
+void reset_fill_telemetry(void);
+
+/**
+ * fill_board() screens each board with an upper bound on its words, score
+ * and longest word (tiles reusable) before the exact search, rejecting it
+ * if the bound misses a minimum. On by default; never rejects a board that
+ * meets the constraints.
+ */
+void enable_fill_prefilter(bool on);
+
+/**
+ * Unbiased estimate of a board's word count and score from random walks
+ * (see PATH-SAMPLING ESTIMATOR in libwords.c). Variances are those of the
+ * estimates, so sqrt() gives their standard errors.
+ */
+struct board_estimate {
+    int samples;
+    double words, words_var;
+    double score, score_var;
+    int longest_seen;          // Longest word any walk spelled (a lower bound)
+};
+
+void estimate_board(int score_counts[], int width, int height, const char *dice, int min_legal,
+                    int samples, uint64_t seed, struct board_estimate *out);
+
+/**
+ * With samples > 0, fill_board() estimates each board that passes the
+ * prefilter and rejects it if the estimate plus z standard errors misses
+ * min words or score. Can reject boards that would pass; off by default.
+ */
+void set_fill_estimator(int samples, double z);
+
+// Progress reports from fill_board(); see FILL_BOARD PROGRESS in libwords.c
+struct fill_progress {
+    int tries;                 // Attempts so far, including the current one
+    double elapsed;            // Seconds since fill_board() started
+    double attempts_per_sec;   // Over the whole fill so far
+    int best_words;            // Best near-miss: the most words, score and
+    int best_score;            // longest word of any fully searched board
+    int best_longest;          // (independently; 0 until one is searched)
+};
+
+// Return nonzero to cancel the fill (get_words() then returns NULL)
+typedef int (*fill_progress_fn)(const struct fill_progress *progress, void *user);
+
+void set_fill_progress(fill_progress_fn fn, void *user, int every_tries, int every_ms);
+
+#endif
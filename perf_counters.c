@@ -0,0 +1,94 @@
+#include <string.h>
+#include <unistd.h>
+
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+const char *const perf_counter_names[PC_NUM] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+};
+
+#ifdef __linux__
+
+static const struct { uint32_t type; uint64_t config; } g_events[PC_NUM] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                         | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                         | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+bool perf_counters_open(struct perf_counters *pc) {
+    pc->num_open = 0;
+    for (int i = 0; i < PC_NUM; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = g_events[i].type;
+        attr.config = g_events[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Lets us scale counts when the kernel multiplexes more events than
+        // the PMU has slots for
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        pc->fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (pc->fds[i] >= 0) pc->num_open++;
+    }
+    return pc->num_open > 0;
+}
+
+void perf_counters_start(struct perf_counters *pc) {
+    for (int i = 0; i < PC_NUM; i++) {
+        if (pc->fds[i] < 0) continue;
+        ioctl(pc->fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(pc->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void perf_counters_stop(struct perf_counters *pc, uint64_t totals[PC_NUM]) {
+    for (int i = 0; i < PC_NUM; i++) {
+        if (pc->fds[i] >= 0) ioctl(pc->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < PC_NUM; i++) {
+        if (pc->fds[i] < 0) continue;
+        uint64_t buf[3];  // value, time_enabled, time_running
+        if (read(pc->fds[i], buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0) continue;
+        totals[i] += buf[2] < buf[1] ? (uint64_t)((double)buf[0] * buf[1] / buf[2]) : buf[0];
+    }
+}
+
+void perf_counters_close(struct perf_counters *pc) {
+    for (int i = 0; i < PC_NUM; i++) {
+        if (pc->fds[i] >= 0) close(pc->fds[i]);
+        pc->fds[i] = -1;
+    }
+    pc->num_open = 0;
+}
+
+#else
+
+bool perf_counters_open(struct perf_counters *pc) {
+    for (int i = 0; i < PC_NUM; i++) pc->fds[i] = -1;
+    pc->num_open = 0;
+    return false;
+}
+
+void perf_counters_start(struct perf_counters *pc) { (void)pc; }
+
+void perf_counters_stop(struct perf_counters *pc, uint64_t totals[PC_NUM]) {
+    (void)pc;
+    (void)totals;
+}
+
+void perf_counters_close(struct perf_counters *pc) { (void)pc; }
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * HARDWARE PERFORMANCE COUNTERS FOR BENCHMARKS
+ *
+ * Thin wrapper over Linux perf_event_open(2) counting user-space events
+ * for the calling thread. Each counter is opened independently, so a host
+ * that lacks (say) LLC events still reports the rest. When nothing can be
+ * opened (non-Linux, perf_event_paranoid too strict, no PMU in a VM)
+ * perf_counters_open() returns false and callers fall back to timing only.
+ */
+
+enum perf_counter_id {
+    PC_CYCLES,
+    PC_INSTRUCTIONS,
+    PC_L1D_MISSES,
+    PC_LLC_MISSES,
+    PC_BRANCH_MISSES,
+    PC_NUM
+};
+
+extern const char *const perf_counter_names[PC_NUM];
+
+struct perf_counters {
+    int fds[PC_NUM];      // -1 when that event is unavailable
+    int num_open;
+};
+
+bool perf_counters_open(struct perf_counters *pc);
+void perf_counters_start(struct perf_counters *pc);
+
+/**
+ * Stop counting and add the (multiplex-scaled) counts since the matching
+ * start into totals[]. Unavailable events are left untouched.
+ */
+void perf_counters_stop(struct perf_counters *pc, uint64_t totals[PC_NUM]);
+
+void perf_counters_close(struct perf_counters *pc);
+
+#endif
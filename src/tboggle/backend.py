@@ -1,10 +1,11 @@
 import asyncio
 import json
 import logging
+import time
 import websockets
 from websockets.server import WebSocketServerProtocol
 
-from tboggle.game import Game
+from tboggle.game import FillCancelled, FillProgress, Game, c_words, get_defs
 from tboggle.dice import DiceSet
 
 logger = logging.getLogger(__name__)
@@ -14,6 +15,8 @@ class BoggleBackend:
     def __init__(self, host="localhost", port=8765):
         self.host = host
         self.port = port
+        # libwords solves one board at a time; fills run on a worker thread
+        self._solver = asyncio.Lock()
 
     async def handle_message(self, websocket: WebSocketServerProtocol, path: str):
         """Handle incoming WebSocket messages."""
@@ -27,7 +30,9 @@ class BoggleBackend:
                     if endpoint == "restore_game":
                         response = await self.restore_game(params)
                     elif endpoint == "fill_board":
-                        response = await self.fill_board(params)
+                        response = await self.fill_board(params, websocket)
+                    elif endpoint == "definitions":
+                        response = await self.definitions(params)
                     else:
                         response = {
                             "error": f"Unknown endpoint: {endpoint}",
@@ -54,6 +59,28 @@ class BoggleBackend:
         except Exception as e:
             logger.exception("Unexpected error in handle_message")
 
+    @staticmethod
+    def _game_state(game: Game, include_definitions: bool) -> dict:
+        """Game state sent to clients, optionally with every legal word's definition."""
+        state = {
+            "board": game.board,
+            "legal_words": list(game.legal.words),
+            "legal_score": game.legal.score,
+            "legal_longest": game.legal.longest,
+            "found_words": list(game.found.words),
+            "found_score": game.found.score,
+            "found_longest": game.found.longest,
+            "bad_words": list(game.bad.words),
+            "duration": game.duration,
+            "min_legal": game.min_legal,
+            "scores": game.scores,
+            "difficulty": game.difficulty
+        }
+        if include_definitions:
+            # One batched native lookup instead of a round trip per word
+            state["definitions"] = get_defs(game.legal.words)
+        return state
+
     async def restore_game(self, params: dict) -> dict:
         """Restore a game using the provided parameters."""
         try:
@@ -94,24 +121,13 @@ class BoggleBackend:
             )
             
             # Restore the game
-            game.restore_game(dice)
+            async with self._solver:
+                game.restore_game(dice)
             
             # Return game state
             return {
                 "status": "success",
-                "game_state": {
-                    "board": game.board,
-                    "legal_words": list(game.legal.words),
-                    "legal_score": game.legal.score,
-                    "legal_longest": game.legal.longest,
-                    "found_words": list(game.found.words),
-                    "found_score": game.found.score,
-                    "found_longest": game.found.longest,
-                    "bad_words": list(game.bad.words),
-                    "duration": game.duration,
-                    "min_legal": game.min_legal,
-                    "scores": game.scores
-                }
+                "game_state": self._game_state(game, params.get("include_definitions", False))
             }
             
         except Exception as e:
@@ -121,8 +137,13 @@ class BoggleBackend:
                 "status": "error"
             }
 
-    async def fill_board(self, params: dict) -> dict:
-        """Fill a board using the provided parameters."""
+    async def fill_board(self, params: dict, websocket: WebSocketServerProtocol = None) -> dict:
+        """Fill a board using the provided parameters.
+
+        With progress_ms, a {"status": "progress", ...} message is sent that
+        often until the board is ready. With timeout (seconds), the fill gives
+        up after that long. A fill also stops if the client disconnects.
+        """
         try:
             # Extract required parameters
             dice_set_name = params.get("dice_set")
@@ -141,6 +162,10 @@ class BoggleBackend:
             max_longest = params.get("max_longest", -1)
             max_tries = params.get("max_tries", 100000)
             random_seed = params.get("random_seed")
+            min_difficulty = params.get("min_difficulty", 0)
+            max_difficulty = params.get("max_difficulty", -1)
+            progress_ms = params.get("progress_ms")
+            timeout = params.get("timeout")
             
             # Validate required parameters
             if not all([dice_set_name, height, width, scores]):
@@ -156,6 +181,13 @@ class BoggleBackend:
                     "error": f"Unknown dice set: {dice_set_name}",
                     "status": "error"
                 }
+
+            # Difficulty is only known with this set's word weights table loaded
+            if (min_difficulty > 0 or max_difficulty != -1) and c_words.word_weights != dice_set_name:
+                return {
+                    "error": f"min_difficulty/max_difficulty need word weights for dice set {dice_set_name}",
+                    "status": "error"
+                }
             
             # Create game instance
             game = Game(
@@ -167,36 +199,50 @@ class BoggleBackend:
                 min_legal=min_legal
             )
             
-            # Fill the board
-            game.fill_board(
-                min_words=min_words,
-                max_words=max_words,
-                min_score=min_score,
-                max_score=max_score,
-                min_longest=min_longest,
-                max_longest=max_longest,
-                max_tries=max_tries,
-                random_seed=random_seed
-            )
+            # Fill the board off the event loop, reporting from the C
+            # generator's progress callback (on the worker thread)
+            loop = asyncio.get_running_loop()
+            deadline = time.monotonic() + timeout if timeout else None
+
+            def report(p: FillProgress) -> bool:
+                if websocket is not None and progress_ms:
+                    message = json.dumps({
+                        "status": "progress",
+                        "endpoint": "fill_board",
+                        "progress": {name: getattr(p, name) for name, _ in FillProgress._fields_},
+                    })
+                    asyncio.run_coroutine_threadsafe(websocket.send(message), loop)
+                closed = websocket is not None and websocket.closed
+                return closed or (deadline is not None and time.monotonic() > deadline)
+
+            async with self._solver:
+                await asyncio.to_thread(
+                    game.fill_board,
+                    min_words=min_words,
+                    max_words=max_words,
+                    min_score=min_score,
+                    max_score=max_score,
+                    min_longest=min_longest,
+                    max_longest=max_longest,
+                    max_tries=max_tries,
+                    random_seed=random_seed,
+                    min_difficulty=min_difficulty,
+                    max_difficulty=max_difficulty,
+                    progress=report,
+                    progress_ms=progress_ms or 100,
+                )
             
             # Return game state
             return {
                 "status": "success",
-                "game_state": {
-                    "board": game.board,
-                    "legal_words": list(game.legal.words),
-                    "legal_score": game.legal.score,
-                    "legal_longest": game.legal.longest,
-                    "found_words": list(game.found.words),
-                    "found_score": game.found.score,
-                    "found_longest": game.found.longest,
-                    "bad_words": list(game.bad.words),
-                    "duration": game.duration,
-                    "min_legal": game.min_legal,
-                    "scores": game.scores
-                }
+                "game_state": self._game_state(game, params.get("include_definitions", False))
             }
             
+        except FillCancelled as e:
+            return {
+                "error": str(e),
+                "status": "error"
+            }
         except Exception as e:
             logger.exception("Error in fill_board")
             return {
@@ -204,8 +250,25 @@ class BoggleBackend:
                 "status": "error"
             }
 
+    async def definitions(self, params: dict) -> dict:
+        """Definitions for a word list (e.g. a board's legal words) in one batch."""
+        words = params.get("words")
+        if not isinstance(words, list):
+            return {
+                "error": "Missing required parameter: words",
+                "status": "error"
+            }
+        return {
+            "status": "success",
+            "definitions": get_defs(words)
+        }
+
     async def start_server(self):
-        """Start the WebSocket server."""
+        """Start the WebSocket server.
+
+        Responses are compressed on the wire by websockets' default
+        permessage-deflate extension, which matters for bulk definitions.
+        """
         logger.info(f"Starting WebSocket server on {self.host}:{self.port}")
         async with websockets.serve(self.handle_message, self.host, self.port):
             logger.info("WebSocket server started successfully")
@@ -0,0 +1,122 @@
+"""
+Reader for board_stats output (see board_stats.c and board_enum.c at the
+repo root).
+
+Holds the Monte-Carlo distributions of word count, score and longest word
+for each dice set, and answers the questions built on them: what fraction
+of random boards meets a set of fill_board constraints (feasibility), and
+how many tries or banked boards that implies.
+"""
+from __future__ import annotations
+
+import dataclasses
+import math
+
+
+@dataclasses.dataclass
+class SetStats:
+    set: str
+    size: int
+    boards: int
+    seed: int
+    min_legal: int
+    words_bin: int
+    score_bin: int
+    mean: tuple[float, float, float]
+    quantiles: list[float]
+    q_words: list[int]
+    q_score: list[int]
+    q_longest: list[int]
+    words: dict[int, int]
+    score: dict[int, int]
+    longest: dict[int, int]
+    # (words bin, score bin, longest) -> boards
+    joint: dict[tuple[int, int, int], int]
+    # 1 for board_enum output: counts are exact outcome weights, not samples
+    exact: int = 0
+
+    def quantile(self, metric: str, q: float) -> int:
+        """
+        Value of metric ("words", "score" or "longest") at quantile q,
+        computed from the exact histogram.
+        """
+        hist = getattr(self, metric)
+        rank = q * (self.boards - 1)
+        seen = 0
+        for value in sorted(hist):
+            seen += hist[value]
+            if seen > rank:
+                return value
+        return max(hist)
+
+    def pass_probability(
+            self,
+            min_words: int = 0, max_words: int = -1,
+            min_score: int = 0, max_score: int = -1,
+            min_longest: int = 0, max_longest: int = -1,
+    ) -> float:
+        """
+        Estimated fraction of random boards meeting the constraints (same
+        meaning as Game.fill_board(); -1 = no maximum).
+
+        Uses the joint distribution; a bin that straddles a limit counts in
+        proportion to its overlap, as if its boards were spread evenly.
+        """
+        def overlap(b: int, width: int, lo: int, hi: int) -> float:
+            start = b * width
+            end = start + width - 1
+            if hi < 0:
+                hi = math.inf
+            covered = min(end, hi) - max(start, lo) + 1
+            return max(0, min(covered, width)) / width
+
+        passing = 0.0
+        for (wb, sb, longest), count in self.joint.items():
+            if longest < min_longest or (0 <= max_longest < longest):
+                continue
+            passing += (count
+                        * overlap(wb, self.words_bin, min_words, max_words)
+                        * overlap(sb, self.score_bin, min_score, max_score))
+        return passing / self.boards
+
+    def expected_tries(self, **constraints) -> float:
+        """
+        Mean fill_board attempts per accepted board (inf if no sampled
+        board qualifies). Also the number of random boards to solve per
+        board banked for these constraints.
+        """
+        p = self.pass_probability(**constraints)
+        return 1 / p if p > 0 else math.inf
+
+
+def _pairs(fields: list[str]) -> dict[int, int]:
+    return dict(tuple(map(int, f.split(":"))) for f in fields)
+
+
+def load(path: str) -> dict[str, SetStats]:
+    """Read a board_stats file, keyed by dice set name."""
+    stats = {}
+    with open(path) as f:
+        block = {}
+        for line in f:
+            if line.startswith("#") or not line.strip():
+                continue
+            key, *fields = line.split()
+            if key == "set":
+                head = dict(zip(fields[1::2], fields[2::2]))
+                block = {"set": fields[0], **{k: int(v) for k, v in head.items()}}
+            elif key == "mean":
+                block["mean"] = tuple(map(float, fields))
+            elif key == "quantiles":
+                block["quantiles"] = list(map(float, fields))
+            elif key.startswith("q_"):
+                block[key] = list(map(int, fields))
+            elif key in ("words", "score", "longest"):
+                block[key] = _pairs(fields)
+            elif key == "joint":
+                block["joint"] = {
+                    tuple(map(int, f.split(":")[:3])): int(f.split(":")[3]) for f in fields
+                }
+            elif key == "end":
+                stats[block["set"]] = SetStats(**block)
+    return stats
@@ -16,9 +16,9 @@ from textual.widget import Widget
 from textual.widgets import Static, Footer, Input, DataTable, Label, Button
 
 from tboggle import fill
-from tboggle.dice import DiceSet
-from tboggle.game import Game, GuessResult, get_def
+from tboggle.game import FillProgress, Game, GuessResult, get_def, get_defs, warmup
 from tboggle.chooser import Chooser, Choices
+from tboggle.prefetch import BoardPrefetcher, new_game
 from tboggle.pause_modal import PauseModal
 from tboggle.exit_modal import ExitModal
 from tboggle.lookup_modal import LookupModal
@@ -150,48 +150,79 @@ class Page:
     total_words: int
 
 class Results(DataTable):
+    """Paged word lists (found, missed, bad) and end-of-game stats.
+
+    Lists are sorted once and kept per title; a page's rows are laid out
+    only when shown and cached per (list, page, geometry), so flipping
+    between large lists doesn't re-lay every page. A resize changes the
+    geometry and drops the cache.
+    """
+
     def on_mount(self) -> None:
         self.cur_page_num = 1
-        self.pages = []
+        self.num_pages = 0
+        self.list_title: Optional[str] = None  # None while showing stats
+        self.words: list[str] = []
+        self._sorted: dict[str, list[str]] = {}
+        self._pages: dict[tuple[str, int, int, int], Page] = {}
         if not self.app.playing:
             self.make_stats()
 
     def on_key(self, event) -> None:
-        if event.key == "space" and self.cur_page_num < len(self.pages):
+        if self.list_title is None:
+            return
+        if event.key == "space" and self.cur_page_num < self.num_pages:
             self.show_page(self.cur_page_num + 1)
         if event.key == "backspace" and self.cur_page_num > 1:
             self.show_page(self.cur_page_num - 1)
 
+    def on_resize(self, event) -> None:
+        if self.list_title is not None:
+            self._pages.clear()
+            self._paginate()
+            self.show_page(min(self.cur_page_num, self.num_pages))
+
     def on_data_table_cell_highlighted(self, event) -> None:
         if not self.disabled and event.value and not self.app.playing:
             word = event.value
-            defn = escape(get_def(word) or "(nothing found)")
+            defn = self.app.definitions.get(word)
+            if defn is None:
+                defn = get_def(word)
+            defn = escape(defn or "(nothing found)")
             score = self.app.game.scores[len(word)]
             self.app.query_one("#def-area").update(f"[u]{word} ({score})[/]: [i]{defn}[/]")
 
     def make_list(self, title: str, words_set: set[str]) -> None:
         self.header_height = 0
 
-        words = list(sorted(words_set))
-        if not words:
-            self.pages = [Page([], title, 0, 0)]
-        else:
-            width = max(len(w) for w in words)
-            num_cols = (self.size.width - 4) // (width + 3)
-            num_rows = self.size.height
-            self.pages = [
-                Page(rows, title, width, len(words))
-                for rows
-                in fill.fill(words, num_cols, num_rows)
-            ]
-
+        # Word sets only grow, so an unchanged size means unchanged contents
+        words = self._sorted.get(title)
+        if words is None or len(words) != len(words_set):
+            words = self._sorted[title] = sorted(words_set)
+        self.list_title = title
+        self.words = words
+        self._paginate()
         self.show_page(1)
 
+    def _paginate(self) -> None:
+        self.col_width = max(map(len, self.words), default=0)
+        self.page_cols = max(1, (self.size.width - 4) // (self.col_width + 3))
+        self.page_rows = max(1, self.size.height)
+        self.num_pages = max(1, fill.num_pages(len(self.words), self.page_cols, self.page_rows))
+
+    def _page(self, num: int) -> Page:
+        key = (self.list_title, num, self.page_cols, self.page_rows)
+        page = self._pages.get(key)
+        if page is None or page.total_words != len(self.words):
+            rows = fill.fill_page(self.words, self.page_cols, self.page_rows, num - 1)
+            page = self._pages[key] = Page(rows, self.list_title, self.col_width, len(self.words))
+        return page
+
     def show_page(self, num: int) -> None:
         self.disabled = False
         self.cur_page_num = num
-        p = self.pages[num - 1]
-        has_next = num < len(self.pages)
+        p = self._page(num)
+        has_next = num < self.num_pages
         has_prev = num > 1
         if has_next and has_prev:
             nav = f" ([orange]BS[/] ↑, [orange]Spc[/]: ↓)"
@@ -202,7 +233,7 @@ class Results(DataTable):
         else:
             nav = ""
         self.border_title = f"{p.label}: {p.total_words}"
-        self.border_subtitle = f"{num}/{len(self.pages)}{nav}"
+        self.border_subtitle = f"{num}/{self.num_pages}{nav}"
         self.clear(columns=True)
         if p.rows:
             self.add_columns(*(f"c{x:{p.col_width}}" for x in p.rows[0]))
@@ -212,6 +243,7 @@ class Results(DataTable):
 
     def make_stats(self) -> None:
         """Generate comprehensive game statistics display."""
+        self.list_title = None
         self.border_title = "Stats"
         self.border_subtitle = ""
         self.clear(columns=True)
@@ -296,6 +328,7 @@ class BoggleApp(App):
         self.time_max = game.duration
         self.my_timer: Optional[Timer] = None
         self.time_widget: Optional[Label] = None  # Cache for timer widget
+        self.definitions: dict[str, str] = {}  # Legal words, fetched at game end
         super().__init__()
 
     def on_mount(self) -> None:
@@ -323,6 +356,8 @@ class BoggleApp(App):
         if self.game.duration:
             self.my_timer.stop()
         self.playing = False
+        # One batched lookup for every word the results can show
+        self.definitions = get_defs(self.game.legal.words)
         self.action_stats()
 
     def compose(self) -> ComposeResult:
@@ -408,33 +443,55 @@ class BoggleApp(App):
 
 def main() -> None:
     import os
+    import sys
 
     os.system('cls' if os.name == 'nt' else 'clear')
+    # Load the dictionary while the chooser is up instead of before it
+    warmup()
+
+    def show_progress(p: FillProgress) -> None:
+        sys.stdout.write(f"\rGenerating board... {p.tries:,} boards tried ({p.attempts_per_sec:,.0f}/s), "
+                         f"best {p.best_words} words, {p.best_score} points, longest {p.best_longest}"
+                         f" - Ctrl-C to give up\x1b[K")
+        sys.stdout.flush()
 
     # size = sys.argv[1] if len(sys.argv) > 1 else "4"
     # dur = int(sys.argv[2]) if len(sys.argv) > 2 else 180
     choices: Choices = None
+    prefetch: Optional[BoardPrefetcher] = None
     while True:
         if not choices:
             result = Chooser().run()
             if not result: break
         choices, start_by = result
 
-        dice_set = DiceSet.get_by_name(choices.set)
-        game = Game(dice_set, dice_set.num, dice_set.num, duration=choices.timeout, min_legal=choices.legal_min, scores=choices.scores)
         if start_by == "restore":
+            # The solver isn't reentrant: stop any background fill first
+            if prefetch:
+                prefetch.cancel()
+                prefetch = None
+            game = new_game(choices)
             # Demo dice configuration for testing (A=65, B=66, C=67, E=69)
             demo_dice = [65, 65, 65, 65, 66, 66, 66, 66, 67, 67, 67, 67, 69, 69, 69, 69]
             game.restore_game(demo_dice)
         else:
-            game.fill_board(
-                min_words=choices.min_words,
-                max_words=choices.max_words,
-                min_score=choices.min_score,
-                max_score=choices.max_score,
-                min_longest=choices.min_longest,
-                max_longest=choices.max_longest,
-            )
+            # Reuse the board prefetched during the last game unless the
+            # choices changed since
+            if prefetch and prefetch.choices != choices:
+                prefetch.cancel()
+                prefetch = None
+            if not prefetch:
+                prefetch = BoardPrefetcher(choices)
+            try:
+                game = prefetch.wait(show_progress)
+            except KeyboardInterrupt:
+                # Give up on these settings and go back to the chooser
+                prefetch.cancel()
+                prefetch = None
+                choices = None
+                continue
+            # Start on the next board while this one is played
+            prefetch = BoardPrefetcher(choices)
         app = BoggleApp(game)
         game_result = app.run()
         if game_result == "board":
@@ -443,6 +500,8 @@ def main() -> None:
             choices = None
         else:
             break
+    if prefetch:
+        prefetch.cancel()
 
 if __name__ == "__main__":
     main()
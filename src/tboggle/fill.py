@@ -1,4 +1,4 @@
-from typing import List, TypeVar
+from typing import List, Sequence, TypeVar
 
 T = TypeVar('T')
 
@@ -28,51 +28,36 @@ def fill(words: List[T], col_pp: int, rows_pp: int) -> List[List[List[T]]]:
         ... ]
         True
     """
-    def create_columns(page_words: List[T], num_cols: int) -> List[List[T]]:
-        columns = []
-        for col in range(num_cols):
-            column_items = [
-                page_words[col * rows_pp + row]
-                for row in range(rows_pp)
-                if col * rows_pp + row < len(page_words)
-            ]
-            columns.append(column_items)
-        return columns
+    return [fill_page(words, col_pp, rows_pp, page) for page in range(num_pages(len(words), col_pp, rows_pp))]
 
-    def transpose_to_rows(columns: List[List[T]]) -> List[List[T]]:
-        rows = []
-        for row_idx in range(rows_pp):
-            row_items = [
-                col[row_idx] for col in columns
-                if row_idx < len(col)
-            ]
-            if row_items:
-                rows.append(row_items)
-        return rows
 
-    def pad_rows(rows: List[List[T]]) -> None:
-        if not rows:
-            return
-        target_length = len(rows[0])
-        for row in rows:
-            row.extend([''] * (target_length - len(row)))
+def num_pages(num_words: int, col_pp: int, rows_pp: int) -> int:
+    """Number of pages fill() lays num_words items out on."""
+    return -(-num_words // (col_pp * rows_pp))
 
-    pages = []
-    pos = 0
-    items_per_page = col_pp * rows_pp
-
-    while pos < len(words):
-        page_words = words[pos:pos + items_per_page]
-
-        # Calculate actual columns needed for this page
-        actual_cols = min(col_pp, (len(page_words) + rows_pp - 1))
-
-        # Process page layout
-        columns = create_columns(page_words, actual_cols)
-        rows = transpose_to_rows(columns)
-        pad_rows(rows)
-        pages.append(rows)
 
-        pos += items_per_page
+def fill_page(words: Sequence[T], col_pp: int, rows_pp: int, page: int) -> List[List[T]]:
+    """
+    Rows of one page of fill(words, col_pp, rows_pp), computed from that
+    page's slice of words alone, so a page can be laid out on demand.
 
-    return pages
+    Example:
+        >>> fill_page(list("abcdefghijklmnopqrstuvwxyz"), 2, 3, 1)
+        [['g', 'j'], ['h', 'k'], ['i', 'l']]
+    """
+    items_per_page = col_pp * rows_pp
+    page_words = words[page * items_per_page:(page + 1) * items_per_page]
+
+    # Column-wise: item (col, row) is page_words[col * rows_pp + row]
+    num_cols = -(-len(page_words) // rows_pp)
+    rows = []
+    for row_idx in range(min(rows_pp, len(page_words))):
+        row = [page_words[col * rows_pp + row_idx]
+               for col in range(num_cols)
+               if col * rows_pp + row_idx < len(page_words)]
+        rows.append(row)
+
+    # Pad short rows to the width of the first
+    for row in rows:
+        row.extend([''] * (len(rows[0]) - len(row)))
+    return rows
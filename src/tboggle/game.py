@@ -1,11 +1,11 @@
-import sqlite3
 import os
-import glob
+import threading
 from random import randint
-from ctypes import cdll, POINTER, c_int, c_short, c_char_p, byref
+from ctypes import (cdll, CFUNCTYPE, POINTER, Structure, c_double, c_int, c_short, c_char_p, c_void_p,
+                    byref, create_string_buffer)
 from enum import Enum
 from collections import Counter
-from typing import Optional
+from typing import Callable, Iterable, Optional
 
 from tboggle.dice import DiceSet
 
@@ -19,6 +19,8 @@ def _find_libwords() -> str:
     Raises:
         FileNotFoundError: If no libwords shared library is found.
     """
+    import glob  # Deferred with the rest of the load (see _Library)
+
     module_dir = os.path.dirname(__file__)
     pattern = os.path.join(module_dir, "libwords*.so")
     matches = glob.glob(pattern)
@@ -35,11 +37,147 @@ def _find_libwords() -> str:
     
     return matches[0]
 
-c_words = cdll.LoadLibrary(_find_libwords())
+class _Library:
+    """libwords and its data files, loaded on first use.
+
+    Importing this module costs nothing: the shared library, words.dat
+    and the definition files are loaded by the first call into C (or by
+    warmup(), e.g. while the chooser is on screen). Loading is locked, so
+    a warmup thread, a board prefetch and the UI can race to it safely.
+    """
+
+    def __init__(self) -> None:
+        self._lib = None
+        self._lock = threading.Lock()
+        self.native_defs = False  # defs.dat mapped
+        self.defs_index = False   # defs_index.dat mapped
+        self.word_weights = None  # Dice set name of the mapped load_word_weights() table
+
+    def load(self):
+        if self._lib is None:
+            with self._lock:
+                if self._lib is None:
+                    lib = cdll.LoadLibrary(_find_libwords())
+                    lib.read_dawg(c_char_p(_find_data_file("words.dat").encode("utf8")))
+                    lib.num_dawg_words()  # Word ID table, built before any threads use it
+                    # Definitions come from the memory-mapped store (lock-free, any
+                    # thread); all.sqlite3 is only opened if defs.dat is missing
+                    # (run build_defs.py)
+                    self.native_defs = bool(lib.load_definitions(
+                        c_char_p(_find_data_file("defs.dat").encode("utf8"))))
+                    self.defs_index = bool(lib.load_definition_index(
+                        c_char_p(_find_data_file("defs_index.dat").encode("utf8"))))
+                    self._lib = lib
+        return self._lib
+
+    def __getattr__(self, name: str):
+        return getattr(self.load(), name)
+
+c_words = _Library()
+MAX_WORD_LEN = 16  # libwords.h
+
+def warmup() -> threading.Thread:
+    """Load libwords and the dictionary on a background thread."""
+    thread = threading.Thread(target=c_words.load, name="libwords-warmup", daemon=True)
+    thread.start()
+    return thread
 
 def read_dawg(path: str) -> None:
     c_words.read_dawg(c_char_p(path.encode("utf8")))
 
+def load_word_list(path: str) -> bool:
+    """Use a plain word list (one word per line) as the dictionary.
+
+    Meant for small lists, e.g. for young players; libwords then times its
+    two solving engines and picks the faster for each board size. Word
+    weights and the native definition files belong to words.dat and are
+    dropped: get_def() falls back to all.sqlite3, and search_defs() finds
+    nothing. Call only while no board is being solved or prefetched.
+
+    Returns:
+        True if loaded, False (dictionary unchanged) if unreadable, empty,
+        or over libwords' cap of about two million letters in all (2^21
+        trie nodes, roughly 200k words).
+    """
+    if not c_words.load_word_list(c_char_p(path.encode("utf8"))):
+        return False
+    c_words.num_dawg_words()  # Word ID table, built before any threads use it
+    c_words.native_defs = c_words.defs_index = False
+    c_words.word_weights = None
+    return True
+
+def word_to_id(word: str) -> int:
+    """Get a word's dense dictionary ID (its alphabetical rank).
+
+    Args:
+        word: The word to look up (case insensitive).
+
+    Returns:
+        ID in 0 .. number of dictionary words - 1, or -1 if not a word.
+    """
+    return c_words.word_to_id(c_char_p(word.upper().encode("utf8")))
+
+def id_to_word(word_id: int) -> str:
+    """Get the word with a dictionary ID ("" if out of range)."""
+    buf = create_string_buffer(MAX_WORD_LEN + 1)
+    return buf.value.decode("utf8") if c_words.id_to_word(word_id, buf) else ""
+
+def find_matches(
+        pattern: str = "*",
+        letters: Optional[str] = None,
+        min_len: int = 0,
+        max_len: int = -1,
+        limit: int = 100,
+) -> list[str]:
+    """Find dictionary words by pattern and/or available letters.
+
+    Runs as a single pruned walk of the DAWG, fast enough to call on every
+    keystroke.
+
+    Args:
+        pattern: Letters plus '?' (any one letter) and '*' (any run, possibly
+            empty), e.g. "S?RE*"; "PRE*" lists words starting with PRE.
+        letters: If given, words must be spelled from these letters, each
+            used at most once; '?' is a blank.
+        min_len: Shortest word to return.
+        max_len: Longest word to return (-1 = no limit).
+        limit: Most words to return.
+
+    Returns:
+        Matching words in alphabetical order (empty for an invalid pattern).
+    """
+    ids = (c_int * max(limit, 0))()
+    found = c_words.find_matches(
+        c_char_p(pattern.encode("utf8")),
+        None if letters is None else c_char_p(letters.encode("utf8")),
+        min_len, max_len, limit, ids)
+    return [id_to_word(ids[i]) for i in range(max(found, 0))]
+
+def anagrams(letters: str, partial: bool = False, min_len: int = 3, limit: int = 100) -> list[str]:
+    """Words using all of letters, or any min_len+ of them if partial."""
+    return find_matches("*", letters, min_len if partial else len(letters), -1, limit)
+
+def load_word_weights(path: str, dice_set_name: str) -> bool:
+    """Load a per-word rarity table (word_probs.c output) for difficulty.
+
+    Once loaded, solves of boards from that dice set compute
+    Game.difficulty and fill_board() honours min_difficulty/max_difficulty.
+    Games using other dice sets get no difficulty.
+
+    Args:
+        path: Path to a word_probs-<set>.dat file.
+        dice_set_name: Dice set the table must have been sampled for.
+
+    Returns:
+        True if the table was mapped, False if missing or not for this
+        dictionary and dice set.
+    """
+    if not c_words.load_word_weights(c_char_p(path.encode("utf8")),
+                                     c_char_p(dice_set_name.encode("utf8"))):
+        return False  # A table loaded earlier stays in use
+    c_words.word_weights = dice_set_name
+    return True
+
 def _find_data_file(filename: str) -> str:
     """Find data file in package.
     
@@ -61,8 +199,19 @@ def _find_data_file(filename: str) -> str:
     print(f"Warning: using local copy {filename}")
     return filename
 
-read_dawg(_find_data_file("words.dat"))
-db = sqlite3.connect(_find_data_file("all.sqlite3"))
+def load_definitions(path: str) -> bool:
+    """Map a definition store (build_defs.py output) for get_def().
+
+    Returns:
+        True if the store was mapped, False if missing or not for this dictionary.
+    """
+    return bool(c_words.load_definitions(c_char_p(path.encode("utf8"))))
+
+def load_definition_index(path: str) -> bool:
+    """Map the reverse-lookup index (build_defs.py --index) for search_defs()."""
+    return bool(c_words.load_definition_index(c_char_p(path.encode("utf8"))))
+
+_db = None  # sqlite3 connection, only opened without defs.dat
 GET_WORD_SQL = "SELECT def FROM defs WHERE word = ?"
 def get_def(word: str) -> str:
     """Get dictionary definition for a word.
@@ -73,11 +222,103 @@ def get_def(word: str) -> str:
     Returns:
         Definition string, or empty string if not found.
     """
-    r = db.execute(GET_WORD_SQL, [word.upper()])
+    global _db
+    c_words.load()
+    if c_words.native_defs:
+        word_id = word_to_id(word)
+        if word_id < 0:
+            return ""
+        buf = create_string_buffer(1024)
+        length = c_words.get_definition(word_id, buf, len(buf))
+        if length >= len(buf):
+            buf = create_string_buffer(length + 1)
+            length = c_words.get_definition(word_id, buf, len(buf))
+        return buf.value.decode("utf8") if length > 0 else ""
+    if _db is None:
+        import sqlite3
+        _db = sqlite3.connect(_find_data_file("all.sqlite3"))
+    r = _db.execute(GET_WORD_SQL, [word.upper()])
     defn = r.fetchone()
     return "" if defn is None else defn[0]
 
 
+def get_defs(words: Iterable[str]) -> dict[str, str]:
+    """Get definitions for a whole word list in one native call.
+
+    Meant for end-of-game results: the store visits the words in ID
+    order, so each compressed block is inflated once, instead of one
+    lookup per word.
+
+    Args:
+        words: Words to look up (case insensitive).
+
+    Returns:
+        Definition per word as given ("" if not found).
+    """
+    words = list(words)
+    c_words.load()
+    if not c_words.native_defs:
+        return {word: get_def(word) for word in words}
+    ids = (c_int * len(words))(*map(word_to_id, words))
+    offsets = (c_int * len(words))()
+    size = 64 * len(words) + 1
+    buf = create_string_buffer(size)
+    needed = c_words.get_definitions(ids, len(words), buf, size, offsets)
+    if needed > size:
+        size = needed
+        buf = create_string_buffer(size)
+        needed = c_words.get_definitions(ids, len(words), buf, size, offsets)
+    if needed < 0:
+        return {word: get_def(word) for word in words}
+    raw = buf.raw
+    return {
+        word: raw[off:raw.index(b"\0", off)].decode("utf8") if off >= 0 else ""
+        for word, off in zip(words, offsets)
+    }
+
+
+def search_defs(query: str, limit: int = 20) -> list[str]:
+    """Find words whose definition mentions every word of query.
+
+    Each query word matches as a prefix ("music instr" finds "a musical
+    instrument"); best matches first. Uses the defs_index.dat inverted
+    index (build_defs.py), answering in about a millisecond.
+
+    Returns:
+        Matching words, or an empty list if there is no index.
+    """
+    c_words.load()
+    if not c_words.defs_index or limit <= 0:
+        return []
+    ids = (c_int * limit)()
+    found = c_words.search_definitions(c_char_p(query.encode("utf8")), limit, ids)
+    return [id_to_word(ids[i]) for i in range(max(found, 0))]
+
+
+class FillProgress(Structure):
+    """Progress report from Game.fill_board() (struct fill_progress in libwords.h).
+
+    best_words, best_score and best_longest are the best near-miss so far:
+    the most words, highest score and longest word of any board that was
+    searched to the end, each on its own.
+    """
+    _fields_ = [
+        ("tries", c_int),
+        ("elapsed", c_double),
+        ("attempts_per_sec", c_double),
+        ("best_words", c_int),
+        ("best_score", c_int),
+        ("best_longest", c_int),
+    ]
+
+# ctypes takes the GIL back for the duration of each call into Python
+_FILL_PROGRESS_FN = CFUNCTYPE(c_int, POINTER(FillProgress), c_void_p)
+
+
+class FillCancelled(Exception):
+    """Game.fill_board() stopped because its progress callback asked to."""
+
+
 class WordList:
     """Container for tracking words and their associated scores.
     
@@ -139,6 +380,8 @@ class Game:
         board: 2D grid of letter faces.
         duration: Game time limit in seconds (0 = no limit).
         min_legal: Minimum word length to be considered valid.
+        difficulty: Total rarity of the legal words in bits (None without a
+            word weights table for this dice set).
     """
     dice_set: DiceSet
     height: int
@@ -150,6 +393,7 @@ class Game:
     board: list[list[str]]
     duration: int
     min_legal: int
+    difficulty: Optional[int]
 
     def __init__(
             self,
@@ -180,6 +424,7 @@ class Game:
         self.board = []
         self.duration = duration
         self.min_legal = min_legal
+        self.difficulty = None
 
     def restore_game(self, dice: str) -> None:
         """Restore game from a specific dice configuration.
@@ -209,6 +454,10 @@ class Game:
             max_longest: int = -1,
             max_tries: int = 1_000_000,
             random_seed: Optional[int] = None,
+            min_difficulty: int = 0,
+            max_difficulty: int = -1,
+            progress: Optional[Callable[[FillProgress], bool]] = None,
+            progress_ms: int = 100,
     ) -> None:
         """Generate a random board meeting specified constraints.
         
@@ -221,10 +470,22 @@ class Game:
             max_longest: Maximum length of longest word allowed (-1 = no limit).
             max_tries: Maximum generation attempts before giving up.
             random_seed: RNG seed for reproducible results (None = random).
+            min_difficulty: Minimum difficulty index (needs load_word_weights()).
+            max_difficulty: Maximum difficulty index (-1 = no limit).
+            progress: Called about every progress_ms milliseconds while
+                generating (on the calling thread); return True to give up.
+            progress_ms: Interval between progress calls.
             
         Raises:
+            FillCancelled: If progress asked to stop.
+            ValueError: If difficulty limits are given without word weights
+                for this dice set.
             Exception: If no valid board found within max_tries attempts.
         """
+        if (min_difficulty > 0 or max_difficulty != -1) and c_words.word_weights != self.dice_set.name:
+            # libwords would ignore them, or rate the board by another set's table
+            raise ValueError(f"difficulty limits need a word weights table for dice set "
+                             f"{self.dice_set.name} (load_word_weights())")
         if random_seed is None:
             random_seed = randint(0, 2 ** 32 - 1)
         dice_bytes = [d.encode('utf8') for d in self.dice_set.dice]
@@ -232,24 +493,44 @@ class Game:
         score_arr_type = c_int * len(self.scores)
 
         c_words.get_words.restype = POINTER(c_char_p)
+        c_words.set_difficulty_limits(min_difficulty, max_difficulty)
         tried = c_int(0)
         board_str_b = c_char_p()
 
+        # Exceptions can't cross the C frames: stash one and cancel instead
+        outcome = {}
+        def report(p, _user):
+            try:
+                if progress(p.contents):
+                    outcome["cancelled"] = True
+            except BaseException as e:
+                outcome["error"] = e
+            return bool(outcome)
+        callback = _FILL_PROGRESS_FN(report) if progress else None  # Must outlive the call
+
         import time
         t = time.time()
-        words_p = c_words.get_words(
-            dice_arr_type(*dice_bytes),
-            score_arr_type(*self.scores),
-            self.width, self.height,
-            min_words, max_words,
-            min_score, max_score,
-            min_longest, max_longest,
-            self.min_legal,
-            max_tries,
-            random_seed,
-            byref(tried),
-            byref(board_str_b)
-        )
+        if callback:
+            c_words.set_fill_progress(callback, None, 0, max(progress_ms, 1))
+        try:
+            words_p = c_words.get_words(
+                dice_arr_type(*dice_bytes),
+                score_arr_type(*self.scores),
+                self.width, self.height,
+                min_words, max_words,
+                min_score, max_score,
+                min_longest, max_longest,
+                self.min_legal,
+                max_tries,
+                random_seed,
+                byref(tried),
+                byref(board_str_b)
+            )
+        finally:
+            if callback:
+                c_words.set_fill_progress(None, None, 0, 0)
+        if "error" in outcome: raise outcome["error"]
+        if "cancelled" in outcome: raise FillCancelled(f"cancelled after {time.time() - t:.1f}s")
         if (not words_p): raise Exception(f"didn't find: {time.time() - t}")
 
         self._finish(board_str_b.value.decode('utf-8'), words_p)
@@ -266,6 +547,12 @@ class Game:
             self.legal.add(words[i].decode('utf-8'))
             i += 1
 
+        difficulty = c_words.get_difficulty()
+        if difficulty < 0 or c_words.word_weights != self.dice_set.name:
+            self.difficulty = None  # No table, or one sampled for another set
+        else:
+            self.difficulty = difficulty
+
         for y in range(self.height):
             row = []
             for x in range(self.width):
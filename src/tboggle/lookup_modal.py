@@ -5,7 +5,31 @@ from textual.screen import ModalScreen
 from textual.widgets import Input, Label
 
 from rich.markup import escape
-from tboggle.game import get_def
+from tboggle.game import anagrams, find_matches, get_def, search_defs
+
+MAX_SUGGESTIONS = 24
+
+
+def suggestions(query: str) -> list[str]:
+    """Words for the lookup box as it is typed.
+
+    "S?RE*" is a wildcard pattern ('?' one letter, '*' any run), "=LETTERS"
+    lists anagrams, "+LETTERS" words made from some of the letters,
+    "/some words" words whose definitions mention them, and anything else
+    lists words starting with it.
+    """
+    if query.startswith("/"):
+        return search_defs(query[1:], limit=MAX_SUGGESTIONS)
+    query = query.strip().upper()
+    if query.startswith("=") and len(query) > 1:
+        return anagrams(query[1:], limit=MAX_SUGGESTIONS)
+    if query.startswith("+") and len(query) > 1:
+        return anagrams(query[1:], partial=True, limit=MAX_SUGGESTIONS)
+    if "?" in query or "*" in query:
+        return find_matches(query, limit=MAX_SUGGESTIONS)
+    if len(query) >= 2:
+        return find_matches(query + "*", limit=MAX_SUGGESTIONS)
+    return []
 
 
 class LookupModal(ModalScreen):
@@ -15,13 +39,25 @@ class LookupModal(ModalScreen):
 
     def compose(self):
         with Container():
-            yield Label("Lookup word ([orange]Esc[/] to exit)")
+            yield Label("Lookup word, S?RE* pattern, =anagram, +letters or /definition words ([orange]Esc[/] to exit)")
             yield Input(placeholder="Enter word")
+            yield Label(id="lookup-suggestions")
             yield Label(id="lookup-def")
 
+    @on(Input.Changed)
+    def changed(self, event):
+        words = suggestions(event.value)
+        self.query_one("#lookup-suggestions", Label).update(" ".join(words))
+
     @on(Input.Submitted)
     def submitted(self, event):
-        word = event.value
+        word = event.value.strip()
+        if word.startswith(("=", "+", "/")) or "?" in word or "*" in word:
+            # A query: look up its first match
+            words = suggestions(word)
+            if not words:
+                return
+            word = words[0]
         defn = escape(get_def(word) or "(nothing found)")
         self.query_one(Input).value = ""
-        self.query_one(Label).update(f"[u]{word}[/]: [i]{defn}[/]")
\ No newline at end of file
+        self.query_one("#lookup-def", Label).update(f"[u]{word}[/]: [i]{defn}[/]")
@@ -0,0 +1,94 @@
+"""
+Background generation of the next board.
+
+Game.fill_board() can take seconds with demanding chooser settings. A
+BoardPrefetcher starts generating a board for a set of choices on a worker
+thread as soon as a game starts, so "New Board" can use it immediately.
+The C solver releases the GIL (ctypes), so the worker runs alongside the
+UI. It is not reentrant, though: only one fill may run at a time, and
+the main thread must cancel() the prefetch before solving a board itself.
+
+The worker reports progress through fill_board()'s callback, which is
+also where a cancel() takes effect, within PROGRESS_MS.
+"""
+from __future__ import annotations
+
+import dataclasses
+import threading
+from typing import Callable, Optional
+
+from tboggle.chooser import Choices
+from tboggle.dice import DiceSet
+from tboggle.game import FillCancelled, FillProgress, Game
+
+PROGRESS_MS = 50
+MAX_TRIES = 1_000_000  # Same budget as a direct Game.fill_board()
+
+
+def new_game(choices: Choices) -> Game:
+    dice_set = DiceSet.get_by_name(choices.set)
+    return Game(dice_set, dice_set.num, dice_set.num, duration=choices.timeout,
+                min_legal=choices.legal_min, scores=choices.scores)
+
+
+class BoardPrefetcher:
+    """Fills one board for a snapshot of choices on a daemon thread."""
+
+    def __init__(self, choices: Choices) -> None:
+        # Chooser hands back the same (mutated) object each time; keep a copy
+        self.choices = dataclasses.replace(choices)
+        self.progress = FillProgress()  # Latest report (zeros until the first)
+        self._game: Optional[Game] = None
+        self._error: Optional[Exception] = None
+        self._cancel = threading.Event()
+        self._thread = threading.Thread(target=self._run, name="board-prefetch", daemon=True)
+        self._thread.start()
+
+    def _report(self, progress: FillProgress) -> bool:
+        # progress lives on the C stack: keep a copy
+        self.progress = FillProgress.from_buffer_copy(progress)
+        return self._cancel.is_set()
+
+    def _run(self) -> None:
+        c = self.choices
+        game = new_game(c)
+        try:
+            game.fill_board(
+                min_words=c.min_words, max_words=c.max_words,
+                min_score=c.min_score, max_score=c.max_score,
+                min_longest=c.min_longest, max_longest=c.max_longest,
+                max_tries=MAX_TRIES, progress=self._report, progress_ms=PROGRESS_MS,
+            )
+        except FillCancelled:
+            return
+        except Exception as e:
+            self._error = e
+            return
+        self._game = game
+
+    @property
+    def tries(self) -> int:
+        return self.progress.tries
+
+    @property
+    def ready(self) -> bool:
+        return not self._thread.is_alive()
+
+    def cancel(self) -> None:
+        """Stop the fill and wait for the worker to exit."""
+        self._cancel.set()
+        self._thread.join()
+
+    def wait(self, progress: Optional[Callable[[FillProgress], None]] = None, interval: float = 0.1) -> Game:
+        """The generated board, calling progress(report) while it isn't ready.
+
+        Raises:
+            Exception: If no valid board was found within MAX_TRIES attempts.
+        """
+        while not self.ready:
+            if progress:
+                progress(self.progress)
+            self._thread.join(interval)
+        if self._error:
+            raise self._error
+        return self._game
@@ -0,0 +1,52 @@
+"""
+Memory-mapped per-word appearance table (written by word_probs.c at the
+repo root).
+
+The file is a small header followed by one uint16 per dictionary word ID:
+the word's surprisal, -log2 of the probability that a random board of the
+dice set contains it, in 1/2048 bits (0xFFFF = never seen in the sample).
+Lookups are O(1) by ID; use game.word_to_id() to get one.
+"""
+from __future__ import annotations
+
+import mmap
+import struct
+
+MAGIC = b"LWPROB1\0"
+HEADER = struct.Struct("<8sIIQ32s")
+SCALE = 2048
+NEVER = 0xFFFF
+
+
+class WordProbs:
+    """Rarity table for one dice set.
+
+    Attributes:
+        set: Dice set name the sample was drawn from.
+        boards: Number of boards in the sample.
+        min_legal: Minimum word length used when solving.
+        num_words: Number of word IDs in the table.
+    """
+    set: str
+    boards: int
+    min_legal: int
+    num_words: int
+
+    def __init__(self, path: str) -> None:
+        with open(path, "rb") as f:
+            self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, self.num_words, self.min_legal, self.boards, name = HEADER.unpack_from(self._map)
+        if magic != MAGIC:
+            raise ValueError(f"{path} is not a word probability table")
+        self.set = name.rstrip(b"\0").decode()
+        self._table = memoryview(self._map)[HEADER.size:HEADER.size + 2 * self.num_words].cast("H")
+
+    def surprisal(self, word_id: int) -> float | None:
+        """Bits of surprise at seeing the word on a board (None if never seen)."""
+        value = self._table[word_id]
+        return None if value == NEVER else value / SCALE
+
+    def probability(self, word_id: int) -> float:
+        """Fraction of sampled boards containing the word."""
+        value = self._table[word_id]
+        return 0.0 if value == NEVER else 2.0 ** (-value / SCALE)
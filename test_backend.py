@@ -71,6 +71,49 @@ async def test_backend():
             else:
                 logger.error(f"fill_board test failed: {result}")
             
+            # Test definitions endpoint (bulk lookup for a legal word list)
+            defs_message = {
+                "endpoint": "definitions",
+                "params": {"words": result["game_state"]["legal_words"]}
+            }
+
+            await websocket.send(json.dumps(defs_message))
+            response = await websocket.recv()
+            result = json.loads(response)
+
+            if result["status"] == "success":
+                logger.info("definitions test passed")
+                logger.info(f"Definitions returned: {len(result['definitions'])}")
+            else:
+                logger.error(f"definitions test failed: {result}")
+
+            # Test fill_board progress reports and timeout (no 16-letter board
+            # turns up in a second)
+            slow_message = {
+                "endpoint": "fill_board",
+                "params": {
+                    "dice_set": "4-classic",
+                    "height": 4,
+                    "width": 4,
+                    "scores": [0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11],
+                    "min_longest": 16,
+                    "max_tries": 100000000,
+                    "progress_ms": 200,
+                    "timeout": 1
+                }
+            }
+
+            await websocket.send(json.dumps(slow_message))
+            reports = 0
+            while (result := json.loads(await websocket.recv()))["status"] == "progress":
+                reports += 1
+
+            if reports and result["status"] == "error" and "cancelled" in result["error"]:
+                logger.info("fill_board progress test passed")
+                logger.info(f"Progress reports: {reports}")
+            else:
+                logger.error(f"fill_board progress test failed after {reports} reports: {result}")
+
             # Test invalid endpoint
             invalid_message = {
                 "endpoint": "invalid_endpoint",
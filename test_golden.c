@@ -0,0 +1,324 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "dice_sets.h"
+#include "libwords.h"
+
+/**
+ * GOLDEN BOARD CORPUS RUNNER
+ *
+ * Verifies a solving engine against golden/corpus.tsv and times it. Each
+ * corpus row is a fixed board with its expected word count, score, longest
+ * word and an order-independent hash of the full word list, so an
+ * optimization that changes *which* words come out fails here even if the
+ * counts happen to line up.
+ *
+ *   ./test_golden                       verify default engine, print timings
+ *   ./test_golden --engine NAME         verify a specific engine
+ *   ./test_golden --repeat 5            solve each board 5 times for steadier timing
+ *   ./test_golden --regen 500 > f.tsv   roll 500 boards per dice set, write corpus
+ *
+ * Built with make STATS=1 it also prints the solver counters per board.
+ *
+ * Exit status is 1 if any board disagrees with the corpus.
+ */
+
+#define CORPUS_PATH "golden/corpus.tsv"
+#define MAX_REPORTED_MISMATCHES 10
+
+// "Basic: 1-11" from chooser.py; the corpus stores scores under this table
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+typedef char **(*engine_fn)(int score_counts[], int width, int height, char *dice);
+typedef void (*batch_fn)(int score_counts[], int width, int height, const char *const dice[], int n,
+                         char **words[]);
+
+static char **solve_dawg(int score_counts[], int width, int height, char *dice) {
+    set_solver_engine(ENGINE_DAWG);
+    return restore_game(score_counts, width, height, dice);
+}
+
+static char **solve_reverse(int score_counts[], int width, int height, char *dice) {
+    set_solver_engine(ENGINE_REVERSE);
+    return restore_game(score_counts, width, height, dice);
+}
+
+static void solve_interleaved(int score_counts[], int width, int height, const char *const dice[], int n,
+                              char **words[]) {
+    struct board_totals totals[n];
+    solve_boards(score_counts, width, height, dice, n, 0, totals, words);
+}
+
+/**
+ * An engine solves one board at a time (solve) or a whole group of
+ * same-sized boards at once (batch; words are free()d by the runner).
+ */
+static const struct engine {
+    const char *name;
+    engine_fn solve;
+    batch_fn batch;
+    const char *desc;
+} engines[] = {
+    {"dawg", solve_dawg, NULL, "recursive DAWG search (restore_game)"},
+    {"reverse", solve_reverse, NULL, "dictionary filter and path check (restore_game)"},
+    {"interleaved", NULL, solve_interleaved, "interleaved explicit-stack searches (solve_boards)"},
+};
+
+static const int num_engines = sizeof(engines) / sizeof(engines[0]);
+
+struct board_result {
+    int words;
+    int score;
+    int longest;
+    uint64_t hash;
+};
+
+struct corpus_row {
+    char set[32];
+    int width, height;
+    char dice[MAX_DICE + 1];
+    struct board_result expected;
+};
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * FNV-1a 64 of one word. Word hashes are summed (not chained) so the
+ * list hash does not depend on the order the engine returns words in.
+ */
+static uint64_t hash_word64(const char *word) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    while (*word) {
+        h ^= (unsigned char)*word++;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+static struct board_result summarize(char **words) {
+    struct board_result r = {0, 0, 0, 0};
+    for (int i = 0; words && words[i]; i++) {
+        const int len = strlen(words[i]);
+        r.words++;
+        r.score += g_scores[len];
+        if (len > r.longest) r.longest = len;
+        r.hash += hash_word64(words[i]);
+    }
+    return r;
+}
+
+static const struct engine *find_engine(const char *name) {
+    for (int i = 0; i < num_engines; i++) {
+        if (strcmp(engines[i].name, name) == 0) return &engines[i];
+    }
+    return NULL;
+}
+
+static int regen(const struct engine *eng, int per_set, uint64_t seed) {
+    printf("# tboggle golden corpus (regenerate with: make golden-regen)\n");
+    printf("# seed=%llu boards_per_set=%d scores=", (unsigned long long)seed, per_set);
+    for (int i = 0; i < (int)(sizeof(g_scores) / sizeof(g_scores[0])); i++) {
+        printf(i ? ",%d" : "%d", g_scores[i]);
+    }
+    printf("\n# set\twidth\theight\tdice\twords\tscore\tlongest\thash\n");
+
+    for (int s = 0; s < num_dice_sets; s++) {
+        const struct dice_set *set = &dice_sets[s];
+        uint64_t rng = seed ^ hash_word64(set->name);
+        char dice[MAX_DICE + 1];
+        for (int b = 0; b < per_set; b++) {
+            roll_board(set, &rng, dice);
+            struct board_result r;
+            if (eng->batch) {
+                const char *one[] = {dice};
+                char **words;
+                eng->batch(g_scores, set->num, set->num, one, 1, &words);
+                r = summarize(words);
+                free(words);
+            } else {
+                r = summarize(eng->solve(g_scores, set->num, set->num, dice));
+            }
+            printf("%s\t%d\t%d\t%s\t%d\t%d\t%d\t%016llx\n",
+                   set->name, set->num, set->num, dice,
+                   r.words, r.score, r.longest, (unsigned long long)r.hash);
+        }
+    }
+    return 0;
+}
+
+static struct corpus_row *load_corpus(const char *path, int *count) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+
+    int cap = 4096;
+    struct corpus_row *rows = malloc(cap * sizeof(*rows));
+    char line[256];
+    int n = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (n == cap) {
+            cap *= 2;
+            rows = realloc(rows, cap * sizeof(*rows));
+        }
+        struct corpus_row *r = &rows[n];
+        unsigned long long hash;
+        if (sscanf(line, "%31s %d %d %36s %d %d %d %llx",
+                   r->set, &r->width, &r->height, r->dice,
+                   &r->expected.words, &r->expected.score,
+                   &r->expected.longest, &hash) != 8) {
+            fprintf(stderr, "%s: bad line: %s", path, line);
+            exit(2);
+        }
+        r->expected.hash = hash;
+        n++;
+    }
+    fclose(f);
+    *count = n;
+    return rows;
+}
+
+static void print_solver_stats(const struct solver_stats *st) {
+    const double n = st->solves ? st->solves : 1;
+    printf("\nSolver counters (per board, %lld solves):\n", st->solves);
+    printf("  %-20s %12.1f\n", "nodes visited", st->nodes_visited / n);
+    printf("  %-20s %12.1f\n", "dawg lookups", st->dawg_lookups / n);
+    printf("  %-20s %12.1f\n", "sibling steps", st->sibling_steps / n);
+    printf("  %-20s %12.1f\n", "rejected: bounds", st->rejected_bounds / n);
+    printf("  %-20s %12.1f\n", "rejected: used", st->rejected_used / n);
+    printf("  %-20s %12.1f\n", "rejected: no child", st->rejected_no_child / n);
+    printf("  %-20s %12.1f\n", "words inserted", st->words_inserted / n);
+    printf("  %-20s %12.1f\n", "duplicates", st->duplicates / n);
+    printf("  %-20s %12.1f\n", "fail-fast exits", st->fail_fast_exits / n);
+}
+
+static int verify(const struct engine *eng, const char *path, int repeat) {
+    int count;
+    struct corpus_row *rows = load_corpus(path, &count);
+
+    int mismatches = 0;
+    double total_time = 0;
+    reset_solver_stats();
+
+    printf("Engine: %s (%s)\n", eng->name, eng->desc);
+    printf("Corpus: %s (%d boards, %d repeat)\n\n", path, count, repeat);
+    printf("%-14s %7s %10s %12s %10s\n", "set", "boards", "seconds", "boards/sec", "us/board");
+
+    int start = 0;
+    while (start < count) {
+        // Rows are grouped by set; time each group separately
+        int end = start;
+        while (end < count && strcmp(rows[end].set, rows[start].set) == 0) end++;
+
+        // Batch engines solve the group in one call (sizes match within a set)
+        const char **dice = malloc((end - start) * sizeof(*dice));
+        char ***words = malloc((end - start) * sizeof(*words));
+        for (int i = start; i < end; i++) dice[i - start] = rows[i].dice;
+
+        double t0 = now_seconds();
+        if (eng->batch) {
+            for (int k = 0; k < repeat; k++) {
+                if (k) {
+                    for (int i = start; i < end; i++) free(words[i - start]);
+                }
+                eng->batch(g_scores, rows[start].width, rows[start].height, dice, end - start, words);
+            }
+        }
+        for (int i = start; i < end; i++) {
+            struct corpus_row *r = &rows[i];
+            struct board_result got;
+            if (eng->batch) {
+                got = summarize(words[i - start]);
+                free(words[i - start]);
+            } else {
+                got = summarize(eng->solve(g_scores, r->width, r->height, r->dice));
+                for (int k = 1; k < repeat; k++) {
+                    eng->solve(g_scores, r->width, r->height, r->dice);
+                }
+            }
+            if (got.words != r->expected.words || got.score != r->expected.score ||
+                got.longest != r->expected.longest || got.hash != r->expected.hash) {
+                if (mismatches++ < MAX_REPORTED_MISMATCHES) {
+                    fprintf(stderr,
+                            "MISMATCH %s %s: words %d/%d score %d/%d longest %d/%d hash %016llx/%016llx\n",
+                            r->set, r->dice,
+                            got.words, r->expected.words, got.score, r->expected.score,
+                            got.longest, r->expected.longest,
+                            (unsigned long long)got.hash, (unsigned long long)r->expected.hash);
+                }
+            }
+        }
+        double elapsed = now_seconds() - t0;
+        total_time += elapsed;
+        free(dice);
+        free(words);
+
+        const int solves = (end - start) * repeat;
+        printf("%-14s %7d %10.4f %12.0f %10.2f\n", rows[start].set, end - start,
+               elapsed, solves / elapsed, elapsed * 1e6 / solves);
+        start = end;
+    }
+
+    printf("%-14s %7d %10.4f %12.0f %10.2f\n\n", "total", count, total_time,
+           count * repeat / total_time, total_time * 1e6 / (count * repeat));
+
+    struct solver_stats st;
+    if (get_solver_stats(&st)) print_solver_stats(&st);
+
+    free(rows);
+    if (mismatches) {
+        printf("FAILED: %d of %d boards differ from the corpus\n", mismatches, count);
+        return 1;
+    }
+    printf("OK: all %d boards match\n", count);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *engine_name = engines[0].name;
+    const char *path = CORPUS_PATH;
+    int repeat = 1;
+    int regen_count = 0;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            engine_name = argv[++i];
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+            if (repeat < 1) repeat = 1;
+        } else if (strcmp(argv[i], "--regen") == 0 && i + 1 < argc) {
+            regen_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [--engine NAME] [--repeat N] [--regen N [--seed S]] [corpus]\n", argv[0]);
+            fprintf(stderr, "engines:");
+            for (int e = 0; e < num_engines; e++) fprintf(stderr, " %s", engines[e].name);
+            fprintf(stderr, "\n");
+            return 2;
+        }
+    }
+
+    const struct engine *eng = find_engine(engine_name);
+    if (!eng) {
+        fprintf(stderr, "Unknown engine: %s\n", engine_name);
+        return 2;
+    }
+
+    read_dawg("src/tboggle/words.dat");
+
+    if (regen_count > 0) return regen(eng, regen_count, seed);
+    return verify(eng, path, repeat);
+}
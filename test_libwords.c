@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 // Forward declarations for libwords functions
 void read_dawg(const char *path);
@@ -10,6 +11,24 @@ char **get_words(char *set[], int score_counts[], int width, int height,
                  int min_words, int max_words, int min_score, int max_score,
                  int min_longest, int max_longest, int min_legal, int max_tries,
                  int random_seed, int *num_tries, char **dice_simple);
+int find_matches(const char *pattern, const char *letters, int min_len, int max_len, int limit, int *ids);
+int word_to_id(const char *word);
+bool load_definitions(const char *path);
+int get_definition(int id, char *out, int size);
+bool load_definition_index(const char *path);
+int search_definitions(const char *query, int limit, int *ids);
+void enable_fill_prefilter(bool on);
+struct board_estimate {
+    int samples;
+    double words, words_var;
+    double score, score_var;
+    int longest_seen;
+};
+void estimate_board(int score_counts[], int width, int height, const char *dice, int min_legal,
+                    int samples, uint64_t seed, struct board_estimate *out);
+bool load_word_list(const char *path);
+enum solver_engine { ENGINE_DEFAULT = -1, ENGINE_AUTO, ENGINE_DAWG, ENGINE_REVERSE };
+void set_solver_engine(int engine);
 
 // Dice set for 4x4 Boggle (from DiceSet.get_by_name("4") - exact order from dice.py)
 char *dice_4x4[] = {
@@ -20,6 +39,8 @@ char *dice_4x4[] = {
 };
 
 int main() {
+    int failures = 0;     // Tests 6-8 check themselves; 1-5 print for comparison
+
     // Read the DAWG dictionary
     read_dawg("src/tboggle/words.dat");
     
@@ -77,6 +98,103 @@ int main() {
         }
     }
     printf("%d\n", count2);
-    
+
+    // Test 3: pattern and anagram queries
+    printf("Test 3: find_matches\n");
+    int ids[1000];
+    printf("%d %d %d\n",
+           find_matches("S?RE*", NULL, 0, -1, 1000, ids),      // Wildcards
+           find_matches(NULL, "RETAINS", 7, 7, 1000, ids),      // Anagrams
+           find_matches("QU*", "QUIZ??", 3, 5, 1000, ids));     // Both, with blanks
+
+    // Test 4: definition store
+    printf("Test 4: get_definition\n");
+    char defn[256];
+    if (load_definitions("src/tboggle/defs.dat") && get_definition(word_to_id("QUIZ"), defn, sizeof(defn)) > 0) {
+        printf("%s\n", defn);
+    }
+
+    // Test 5: reverse lookup by definition words
+    printf("Test 5: search_definitions\n");
+    if (load_definition_index("src/tboggle/defs_index.dat")) {
+        printf("%d\n", search_definitions("musical instr", 1000, ids));
+    }
+
+    // Test 6: the relaxed-bound prefilter only skips boards that would fail,
+    // so the same seed must take the same tries to the same board without it
+    printf("Test 6: fill_board prefilter\n");
+    int tries_on = 0, tries_off = 0;
+    char board_on[17] = "", board_off[17] = "";
+    for (int on = 1; on >= 0; on--) {
+        for (int i = 0; i < 16; i++) dice_set[i] = dice_4x4[i];
+        enable_fill_prefilter(on);
+        if (get_words(dice_set, scores, 4, 4, 150, -1, 1, -1, 8, -1, 3, 100000, 1, &num_tries, &dice_simple)) {
+            strcpy(on ? board_on : board_off, dice_simple);
+        }
+        *(on ? &tries_on : &tries_off) = num_tries;
+    }
+    enable_fill_prefilter(true);
+    const bool same = tries_on == tries_off && strcmp(board_on, board_off) == 0;
+    printf("%d %d %s\n", tries_on, tries_off, same ? "same" : "DIFFERENT");
+    failures += !same;
+
+    // Test 7: the path-sampling estimate should land within a few standard
+    // errors of the exact count, and only ever see words that exist
+    printf("Test 7: estimate_board\n");
+    int exact = 0, longest = 0;
+    for (char **w = restore_game(scores, 4, 4, "ADYERESTLPNAGIE1"); *w; w++) {
+        const int len = (int)strlen(*w);
+        if (len < 3) continue;     // restore_game() keeps every length
+        exact++;
+        if (len > longest) longest = len;
+    }
+    struct board_estimate est;
+    estimate_board(scores, 4, 4, "ADYERESTLPNAGIE1", 3, 4096, 1, &est);
+    const double err = est.words - exact;
+    const bool within = err * err <= 16 * est.words_var, longest_ok = est.longest_seen <= longest;
+    printf("%d words, estimate %s, longest seen %s\n", exact,
+           within ? "within 4 SE" : "OFF", longest_ok ? "ok" : "TOO LONG");
+    failures += !within + !longest_ok;
+
+    // Test 8: a word list of the board's own words (half of them) plus words
+    // it can't make; both engines must list exactly the board's half, in
+    // the same order
+    printf("Test 8: load_word_list and engines\n");
+    char list_path[] = "/tmp/test_libwords_XXXXXX";
+    const int fd = mkstemp(list_path);
+    FILE *list = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!list) return 1;
+    int listed = 0;
+    char **board_words = restore_game(scores, 4, 4, "ADYERESTLPNAGIE1");
+    for (int k = 0; board_words[k]; k++) {
+        if (k % 2 == 0 && strlen(board_words[k]) >= 3) {
+            fprintf(list, "%s\n", board_words[k]);
+            listed++;
+        }
+    }
+    fprintf(list, "zebra\nQuixotic\njumpy\nnot-a-word\n");
+    fclose(list);
+    char *found[2][1000];
+    int num_found[2] = {0, 0};
+    if (load_word_list(list_path)) {
+        for (int e = 0; e < 2; e++) {
+            set_solver_engine(e ? ENGINE_REVERSE : ENGINE_DAWG);
+            for (char **w = restore_game(scores, 4, 4, "ADYERESTLPNAGIE1"); *w && num_found[e] < 1000; w++) {
+                found[e][num_found[e]++] = strdup(*w);
+            }
+        }
+    }
+    remove(list_path);
+    bool agree = num_found[0] == listed && num_found[1] == listed;
+    for (int k = 0; agree && k < listed; k++) agree = strcmp(found[0][k], found[1][k]) == 0;
+    printf("%d listed, %d and %d found, %s\n", listed, num_found[0], num_found[1], agree ? "engines agree" : "MISMATCH");
+    failures += !agree;
+    set_solver_engine(ENGINE_DEFAULT);
+    read_dawg("src/tboggle/words.dat");
+
+    if (failures) {
+        printf("FAILED: %d of 4 checks\n", failures);
+        return 1;
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "dice_sets.h"
+#include "libwords.h"
+
+/**
+ * PER-WORD APPEARANCE PROBABILITY
+ *
+ * Solves a large sample of random boards for one dice set and counts, per
+ * dictionary word ID, how many boards contain the word. Each thread counts
+ * into its own array (no locks, no atomics on the hot path); the shards are
+ * summed at the end. Board i comes from its own RNG stream, so the result
+ * does not depend on --threads.
+ *
+ *   ./word_probs --set 4 --boards 1000000 -o word_probs-4.dat
+ *
+ * The output is a struct word_prob_header (libwords.h) followed by one
+ * uint16_t per word ID: the surprisal -log2(p) in 1/WORD_PROB_SCALE bits,
+ * or WORD_PROB_NEVER. It is meant to be memory-mapped, making rarity an
+ * O(1) lookup by word ID (see src/tboggle/word_probs.py).
+ */
+
+#define CHUNK 256
+
+static int g_scores[] = {0, 0, 0, 1, 1, 2, 3, 5, 11, 11, 11, 11, 11, 11, 11, 11, 11};
+
+static const struct dice_set *g_set;
+static long long g_boards = 100000;
+static uint64_t g_seed = 1;
+static int g_min_legal = 3;
+static int g_num_words;
+static atomic_llong g_next;
+static atomic_llong g_done;
+
+static void *count_worker(void *arg) {
+    uint32_t *counts = arg;
+    char dice[MAX_DICE + 1];
+    int ids[MAX_DICE * MAX_DICE * 8];
+    const int n = g_set->num;
+
+    for (;;) {
+        const long long start = atomic_fetch_add_explicit(&g_next, CHUNK, memory_order_relaxed);
+        if (start >= g_boards) break;
+        const long long end = start + CHUNK < g_boards ? start + CHUNK : g_boards;
+        for (long long i = start; i < end; i++) {
+            uint64_t rng = g_seed << 32 ^ (uint64_t)i;
+            roll_board(g_set, &rng, dice);
+            struct board_totals r;
+            solve_board(g_scores, n, n, dice, g_min_legal, &r);
+            const int found = get_word_ids(ids);
+            for (int w = 0; w < found; w++) counts[ids[w]]++;
+        }
+        atomic_fetch_add_explicit(&g_done, end - start, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    const char *set_name = "4";
+    const char *out_path = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (i + 1 >= argc) goto usage;
+        if (strcmp(a, "--set") == 0) set_name = argv[++i];
+        else if (strcmp(a, "--boards") == 0) g_boards = atoll(argv[++i]);
+        else if (strcmp(a, "--threads") == 0) threads = atol(argv[++i]);
+        else if (strcmp(a, "--seed") == 0) g_seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(a, "--min-legal") == 0) g_min_legal = atoi(argv[++i]);
+        else if (strcmp(a, "-o") == 0) out_path = argv[++i];
+        else goto usage;
+    }
+    if (threads < 1) threads = 1;
+    // Surprisal of a single sighting must fit in 16 bits
+    if (g_boards < 1 || g_boards > (1LL << 31)) goto usage;
+
+    g_set = find_dice_set(set_name);
+    if (!g_set) {
+        fprintf(stderr, "Unknown dice set: %s\n", set_name);
+        return 2;
+    }
+    char default_path[64];
+    snprintf(default_path, sizeof(default_path), "word_probs-%s.dat", g_set->name);
+    if (!out_path) out_path = default_path;
+
+    read_dawg("src/tboggle/words.dat");
+    g_num_words = num_dawg_words();    // Builds the ID table before threads start
+
+    pthread_t *tids = malloc(threads * sizeof(*tids));
+    uint32_t **shards = malloc(threads * sizeof(*shards));
+    const double t0 = now_sec();
+    for (int t = 0; t < threads; t++) {
+        shards[t] = calloc(g_num_words, sizeof(uint32_t));
+        if (!shards[t]) {
+            fprintf(stderr, "Out of memory\n");
+            return 2;
+        }
+        pthread_create(&tids[t], NULL, count_worker, shards[t]);
+    }
+    long long done;
+    while ((done = atomic_load_explicit(&g_done, memory_order_relaxed)) < g_boards) {
+        const double elapsed = now_sec() - t0;
+        if (elapsed > 0) {
+            fprintf(stderr, "\rset %-12s %12lld/%lld boards  %9.0f boards/s", g_set->name, done,
+                    g_boards, done / elapsed);
+        }
+        struct timespec pause = {0, 250 * 1000 * 1000};
+        nanosleep(&pause, NULL);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    fprintf(stderr, "\rset %-12s %12lld/%lld boards  %9.0f boards/s\n", g_set->name, g_boards,
+            g_boards, g_boards / (now_sec() - t0));
+
+    for (int t = 1; t < threads; t++) {
+        for (int w = 0; w < g_num_words; w++) shards[0][w] += shards[t][w];
+        free(shards[t]);
+    }
+
+    uint16_t *table = malloc(g_num_words * sizeof(uint16_t));
+    int seen = 0;
+    for (int w = 0; w < g_num_words; w++) {
+        if (!shards[0][w]) {
+            table[w] = WORD_PROB_NEVER;
+            continue;
+        }
+        seen++;
+        const double bits = -log2((double)shards[0][w] / g_boards);
+        table[w] = (uint16_t)lround(bits * WORD_PROB_SCALE);
+    }
+
+    struct word_prob_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, WORD_PROB_MAGIC, sizeof(h.magic));
+    h.num_words = g_num_words;
+    h.min_legal = g_min_legal;
+    h.boards = g_boards;
+    snprintf(h.set, sizeof(h.set), "%s", g_set->name);
+
+    FILE *out = fopen(out_path, "wb");
+    if (!out) {
+        perror(out_path);
+        return 2;
+    }
+    if (fwrite(&h, sizeof(h), 1, out) != 1 || fwrite(table, sizeof(uint16_t), g_num_words, out) != (size_t)g_num_words) {
+        perror(out_path);
+        return 2;
+    }
+    fclose(out);
+    fprintf(stderr, "%s: %d of %d words seen on at least one board\n", out_path, seen, g_num_words);
+    return 0;
+
+usage:
+    fprintf(stderr, "usage: %s [--set NAME] [--boards N (max 2^31)] [--threads N] [--seed N] "
+            "[--min-legal N] [-o FILE]\n", argv[0]);
+    return 2;
+}